@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# SPDX-License-Identifier: GPL-3.0
+#
+# Measures the time the correlator takes per frame for frames of 223,
+# 1115 and 2040 bytes. Run it on a build of 4f174cd^ as well to compare
+# the bulk packing of locked frames against the bit-serial path.
+
+import time
+import random
+from argparse import ArgumentParser
+from gnuradio import gr, blocks
+import gnuradio.ccsds as ccsds
+
+ASM = 0x1acffc1d
+FRAME_LENS = (223, 1115, 2040)
+
+def frame_bits(frame_len):
+    # unpacked bits of one sync word and frame
+    data = [ASM >> 24, (ASM >> 16) & 0xff, (ASM >> 8) & 0xff, ASM & 0xff]
+    data += [random.randint(0, 255) for _ in range(frame_len)]
+    return [(b >> (7 - i)) & 1 for b in data for i in range(8)]
+
+def run(frame_len, n_frames):
+    bits = frame_bits(frame_len)
+    tb = gr.top_block()
+    src = blocks.vector_source_b(bits, True)
+    head = blocks.head(gr.sizeof_char, n_frames * len(bits))
+    corr = ccsds.correlator(ASM, 0xffffffff, 0, frame_len)
+    tb.connect(src, head, corr)
+
+    start = time.time()
+    tb.run()
+    return (time.time() - start) / corr.frame_count()
+
+def main():
+    parser = ArgumentParser()
+    parser.add_argument("-n", "--frames", type=int, default=20000)
+    args = parser.parse_args()
+
+    for frame_len in FRAME_LENS:
+        t = run(frame_len, args.frames)
+        print("%4d bytes: %8.2f us/frame %10.0f frames/s" % (frame_len, 1e6 * t, 1 / t))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# SPDX-License-Identifier: GPL-3.0
+#
+# Compares the frame rate of the CCSDS encoder with tagged input, one
+# frame per call, against untagged input, many frames per call.
+
+import time
+from argparse import ArgumentParser
+from gnuradio import gr, blocks
+import gnuradio.ccsds as ccsds
+
+DATA_LEN = 1115
+
+def run(n_frames, tagged):
+    tb = gr.top_block()
+    src = blocks.vector_source_b([x % 256 for x in range(DATA_LEN)], True)
+    head = blocks.head(gr.sizeof_char, n_frames * DATA_LEN)
+    sink = blocks.null_sink(gr.sizeof_char)
+    if tagged:
+        s2ts = blocks.stream_to_tagged_stream(gr.sizeof_char, 1, DATA_LEN, "packet_len")
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "packet_len")
+        tb.connect(src, head, s2ts, enc, sink)
+    else:
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "")
+        tb.connect(src, head, enc, sink)
+
+    start = time.time()
+    tb.run()
+    return enc.num_frames() / (time.time() - start)
+
+def main():
+    parser = ArgumentParser()
+    parser.add_argument("-n", "--frames", type=int, default=100000)
+    args = parser.parse_args()
+
+    tagged = run(args.frames, True)
+    batch = run(args.frames, False)
+    print("tagged:  %10.0f frames/s" % tagged)
+    print("batched: %10.0f frames/s (%.1fx)" % (batch, batch / tagged))
+
+if __name__ == '__main__':
+    main()
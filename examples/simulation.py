@@ -144,7 +144,7 @@ class simulation(gr.top_block, Qt.QWidget):
         for c in range(1, 2):
             self.top_grid_layout.setColumnStretch(c, 1)
         self.ccsds_encoder = ccsds.ccsds_encoder(gr.sizeof_char, "packet_lenn", True, True, True, False, False, 5, True)
-        self.ccsds_decoder = ccsds.ccsds_decoder(0, True, True, True, False, False, 5, True)
+        self.ccsds_decoder = ccsds.ccsds_decoder(0, True, True, True, False, False, 5, True, 0, 0, False, True)
         self._variable_qtgui_label_0_1_0_0_tool_bar = Qt.QToolBar(self)
 
         if None:
@@ -436,7 +436,6 @@ class simulation(gr.top_block, Qt.QWidget):
         _frames_decoded_thread = threading.Thread(target=_frames_decoded_probe)
         _frames_decoded_thread.daemon = True
         _frames_decoded_thread.start()
-        self.digital_diff_decoder_bb_0 = digital.diff_decoder_bb(2, digital.DIFF_DIFFERENTIAL)
         self.digital_costas_loop_cc_0 = digital.costas_loop_cc(6.28/100, 2, False)
         self.digital_constellation_modulator_0 = digital.generic_mod(
             constellation=digital.constellation_bpsk().base(),
@@ -480,12 +479,11 @@ class simulation(gr.top_block, Qt.QWidget):
         self.connect((self.blocks_throttle_0, 0), (self.qtgui_freq_sink_x_0_0, 0))
         self.connect((self.ccsds_encoder, 0), (self.digital_constellation_modulator_0, 0))
         self.connect((self.digital_clock_recovery_mm_xx_0, 0), (self.digital_costas_loop_cc_0, 0))
-        self.connect((self.digital_constellation_decoder_cb_0, 0), (self.digital_diff_decoder_bb_0, 0))
+        self.connect((self.digital_constellation_decoder_cb_0, 0), (self.ccsds_decoder, 0))
         self.connect((self.digital_constellation_modulator_0, 0), (self.blocks_multiply_const_vxx_0, 0))
         self.connect((self.digital_costas_loop_cc_0, 1), (self.blocks_moving_average_xx_0, 0))
         self.connect((self.digital_costas_loop_cc_0, 0), (self.digital_constellation_decoder_cb_0, 0))
         self.connect((self.digital_costas_loop_cc_0, 0), (self.qtgui_const_sink_x_0, 0))
-        self.connect((self.digital_diff_decoder_bb_0, 0), (self.ccsds_decoder, 0))
 
 
     def closeEvent(self, event):
@@ -32,6 +32,43 @@ namespace gr {
      * \brief Decodes Reed Solomon encoded CCSDS frames
      * \ingroup ccsds
      *
+     * With a slip window of N bits, the sync word following a frame is
+     * looked for at -N..+N bits around its expected position before falling
+     * back to a full search.
+     *
+     * Sync word candidates are recorded while a codeword is being read. If
+     * the codeword fails to decode, the decoder goes back to the next
+     * candidate in its input history, so a false lock does not hide a
+     * frame starting inside it.
+     *
+     * With a queue depth above zero, work() only finds and packs the
+     * codewords and queues them to a decode thread, which decodes and
+     * publishes them. When the queue is full, work() waits for the decode
+     * thread, or drops the codeword if drop_on_overflow is set. Queued
+     * codewords are not retried from an earlier sync word.
+     *
+     * The attached sync marker is 0x1acffc1d by default. Another marker of
+     * up to 64 bits can be given with asm_ and asm_mask, as for the
+     * correlator. Its length is the number of bits covered by the mask and
+     * threshold is the number of masked bits allowed to be wrong.
+     *
+     * rs_e and virtual_fill select the Reed-Solomon code as for the
+     * encoder: E=16 or E=8, shortened by virtual_fill zero symbols that
+     * are not sent.
+     *
+     * With check_fecf set the last two bytes of each decoded frame are
+     * checked as the CRC-16 frame error control field. Frames that fail
+     * are counted, and dropped if drop_fecf_errors is set; otherwise they
+     * are published with fecf_ok false in the metadata.
+     *
+     * With nrzm set the input is NRZ-M coded and is decoded as the bits
+     * are shifted in, so no differential decoder is needed in front.
+     *
+     * The settings below can be changed while running, by their setters or
+     * by a dictionary on the config port with the same keys (threshold,
+     * rs_decode, deinterleave, descramble, n_interleave, dual_basis). New
+     * settings take effect together at the next frame boundary.
+     *
      */
     class CCSDS_API ccsds_decoder : virtual public gr::sync_block
     {
@@ -42,7 +79,7 @@ namespace gr {
        * \brief Return a shared_ptr to a new instance of ccsds::ccsds_decoder.
        *
        */
-      static sptr make(int threshold=0, bool rs_decode=true, bool descramble=true, bool deinterleave=true, bool verbose=false, bool printing=false, int n_interleave=5, bool dual_basis=true);
+      static sptr make(int threshold=0, bool rs_decode=true, bool descramble=true, bool deinterleave=true, bool verbose=false, bool printing=false, int n_interleave=5, bool dual_basis=true, int slip_window=0, int queue_depth=0, bool drop_on_overflow=false, bool nrzm=false, uint64_t asm_=0x1acffc1d, uint64_t asm_mask=0xffffffff, int rs_e=16, int virtual_fill=0, bool check_fecf=false, bool drop_fecf_errors=false);
 
       /*!
        * \brief return number of received frames
@@ -56,6 +93,57 @@ namespace gr {
        * \brief return number of decoded subframes
        */
       virtual uint32_t num_subframes_decoded() const = 0;
+      /*!
+       * \brief return number of bit slips the decoder realigned to
+       */
+      virtual uint32_t num_bit_slips() const = 0;
+      /*!
+       * \brief return number of locks given up after an uncorrectable
+       * first rs block
+       */
+      virtual uint32_t num_false_locks() const = 0;
+      /*!
+       * \brief return number of codewords dropped on a full decode queue
+       */
+      virtual uint32_t num_frames_dropped() const = 0;
+      /*!
+       * \brief return number of decoded frames with a wrong fecf
+       */
+      virtual uint32_t num_fecf_errors() const = 0;
+      /*!
+       * \brief return number of codewords waiting in the decode queue
+       */
+      virtual uint32_t queue_depth() const = 0;
+      /*!
+       * \brief return the largest number of codewords seen in the decode queue
+       */
+      virtual uint32_t max_queue_depth() const = 0;
+
+      /*!
+       * \brief set the maximum number of wrong bits in the sync word,
+       * from 0 to the asm length - 1
+       */
+      virtual void set_threshold(int threshold) = 0;
+      /*!
+       * \brief enable or disable rs decoding
+       */
+      virtual void set_rs_decode(bool rs_decode) = 0;
+      /*!
+       * \brief enable or disable deinterleaving
+       */
+      virtual void set_deinterleave(bool deinterleave) = 0;
+      /*!
+       * \brief enable or disable descrambling
+       */
+      virtual void set_descramble(bool descramble) = 0;
+      /*!
+       * \brief set the interleaving depth, 1 to 8
+       */
+      virtual void set_n_interleave(int n_interleave) = 0;
+      /*!
+       * \brief use the dual basis or conventional representation
+       */
+      virtual void set_dual_basis(bool dual_basis) = 0;
 
     };
 
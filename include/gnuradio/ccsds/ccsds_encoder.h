@@ -23,6 +23,7 @@
 #define INCLUDED_CCSDS_CCSDS_ENCODER_H
 
 #include <gnuradio/ccsds/api.h>
+#include <gnuradio/ccsds/output_format.h>
 #include <gnuradio/tagged_stream_block.h>
 
 namespace gr {
@@ -34,6 +35,50 @@ namespace gr {
      *
      * Description of the block
      *
+     * With an empty len_tag_key the input is not tagged: every data_len
+     * bytes of a stream, or every queued pdu, is one frame, and each call
+     * encodes as many frames back to back as there is input and room for.
+     *
+     * In continuous mode the block takes pdus and never stops sending:
+     * when no pdu is queued it sends an idle transfer frame (spacecraft
+     * scid, virtual channel 7, first header pointer 0x7fe, idle data 0x55)
+     * coded with the current settings. Its virtual channel frame count is
+     * always 0. With segment set the idle frames take the next master
+     * channel frame count along with the data frames. Without it the pdus
+     * are whole frames whose counts the block does not know, and the idle
+     * frames have master channel frame count 0. With a frame_rate above zero frames are sent
+     * at that many per second, otherwise as fast as downstream takes them.
+     *
+     * With segment set the pdus are CCSDS space packets of any length.
+     * They are packed back to back into the data fields of TM transfer
+     * frames for the given spacecraft and virtual channel, split across
+     * frames where needed, and the first header pointer of each frame
+     * points to the first packet that starts in it. A frame that is not
+     * full is held for more packets for at most flush_timeout seconds,
+     * then sent with the rest filled by an idle packet. In continuous
+     * mode a partial frame is sent instead of an idle frame.
+     *
+     * The output is packed bytes, one bit per byte or one float per bit,
+     * as set by output_format. With nrzm set the bits are differentially
+     * coded (NRZ-M) before they are written out, continuing from the last
+     * bit of the previous frame.
+     *
+     * rs_e sets the symbol errors the Reed-Solomon code corrects per block,
+     * 16 for the (255,223) code or 8 for the (255,239) code. virtual_fill
+     * shortens every block by that many leading zero symbols that are not
+     * sent, so a frame carries (255 - 2*rs_e - virtual_fill) * n_interleave
+     * bytes of data.
+     *
+     * With fecf set the last two bytes of each frame's data are the CRC-16
+     * frame error control field of the rest, so pdus and stream frames are
+     * two bytes shorter than the data length. Idle and segmented transfer
+     * frames carry it too.
+     *
+     * The coding settings can be changed while running, by their setters
+     * or by a dictionary on the config port with the same keys (rs_encode,
+     * interleave, scramble, n_interleave, dual_basis). New settings take
+     * effect together at the next frame.
+     *
      */
     class CCSDS_API ccsds_encoder : virtual public gr::tagged_stream_block
     {
@@ -44,13 +89,40 @@ namespace gr {
        * \brief Return a shared_ptr to a new instance of ccsds::ccsds_encoder.
        *
        */
-      static sptr make(size_t itemsize=0, const std::string& len_tag_key="packet_len", bool rs_encode=true, bool interleave=true, bool scramble=true, bool printing=false, bool verbose=false, int n_interleave=5, bool dual_basis=true);
+      static sptr make(size_t itemsize=0, const std::string& len_tag_key="packet_len", bool rs_encode=true, bool interleave=true, bool scramble=true, bool printing=false, bool verbose=false, int n_interleave=5, bool dual_basis=true, bool continuous=false, double frame_rate=0, bool segment=false, int scid=0, int vcid=0, double flush_timeout=0.1, output_format_t output_format=OUTPUT_PACKED, bool nrzm=false, int rs_e=16, int virtual_fill=0, bool fecf=false);
 
       /*!
        * \brief return the number of frames sent
        *
        */
       virtual uint32_t num_frames() const = 0;
+
+      /*!
+       * \brief return the number of idle frames sent in continuous mode
+       *
+       */
+      virtual uint32_t num_idle_frames() const = 0;
+
+      /*!
+       * \brief enable or disable rs encoding
+       */
+      virtual void set_rs_encode(bool rs_encode) = 0;
+      /*!
+       * \brief enable or disable interleaving
+       */
+      virtual void set_interleave(bool interleave) = 0;
+      /*!
+       * \brief enable or disable scrambling
+       */
+      virtual void set_scramble(bool scramble) = 0;
+      /*!
+       * \brief set the interleaving depth, 1 to 8
+       */
+      virtual void set_n_interleave(int n_interleave) = 0;
+      /*!
+       * \brief use the dual basis or conventional representation
+       */
+      virtual void set_dual_basis(bool dual_basis) = 0;
     };
 
   } // namespace ccsds
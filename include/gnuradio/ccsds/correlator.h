@@ -24,6 +24,7 @@
 
 #include <gnuradio/ccsds/api.h>
 #include <gnuradio/sync_block.h>
+#include <vector>
 
 namespace gr {
   namespace ccsds {
@@ -33,6 +34,18 @@ namespace gr {
      * \ingroup ccsds
      *
      * looks for the attached sync marker and produces pdus containing frames
+     *
+     * Several sync markers can be searched for at once, each with its own
+     * mask, threshold and frame length. The index of the marker that was
+     * found and its value are added to the pdu metadata as "asm_index" and
+     * "asm".
+     *
+     * With a slip window of N bits, the marker following a frame is looked
+     * for at -N..+N bits around its expected position before falling back
+     * to a full search, so that the correlator stays locked through bit
+     * slips.
+     *
+     * With nrzm set the input is NRZ-M coded and is decoded on the way in.
      */
     class CCSDS_API correlator : virtual public gr::sync_block
     {
@@ -46,21 +59,50 @@ namespace gr {
        * \param asm_mask mask for attached sync marker
        * \param threshold maximum number of allowed errors in asm
        * \param frame_len length of the transfer frame
+       * \param slip_window number of bits the next asm may be early or late
+       * \param nrzm decode NRZ-M coded input
        */
       static sptr make(const uint64_t asm_=0x1acffc1d,
                        const uint64_t asm_mask=0xffffffff, 
                        const uint8_t threshold=2, 
-                       const size_t frame_len=223);
+                       const size_t frame_len=223,
+                       const int slip_window=0,
+                       const bool nrzm=false);
+
+      /*!
+       * \brief make the correlator for several sync markers.
+       *
+       * all vectors must have the same length, one entry per marker. when
+       * several markers match at once the first one in the list wins.
+       *
+       * \param asms attached sync markers
+       * \param asm_masks masks for the attached sync markers
+       * \param thresholds maximum number of allowed errors in each asm
+       * \param frame_lens length of the transfer frame following each asm
+       * \param slip_window number of bits the next asm may be early or late
+       * \param nrzm decode NRZ-M coded input
+       */
+      static sptr make(const std::vector<uint64_t> &asms,
+                       const std::vector<uint64_t> &asm_masks,
+                       const std::vector<uint8_t> &thresholds,
+                       const std::vector<size_t> &frame_lens,
+                       const int slip_window=0,
+                       const bool nrzm=false);
 
       /*!
        * \brief number of frames detected
        */
       virtual uint64_t frame_count() const = 0;
 
+      /*!
+       * \brief number of bit slips the correlator realigned to
+       */
+      virtual uint64_t num_bit_slips() const = 0;
+
     };
 
-    enum state_t { SEARCH, LOCK };
-    const char* state_names[] = { "SEARCH", "LOCK" };
+    enum state_t { SEARCH, LOCK, RESYNC };
+    const char* state_names[] = { "SEARCH", "LOCK", "RESYNC" };
 
     enum ambiguity_t { NONE, INVERTED };
     const char* ambiguity_names[] = { "NONE", "INVERTED" };
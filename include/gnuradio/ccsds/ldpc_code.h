@@ -0,0 +1,43 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CCSDS_LDPC_CODE_H
+#define INCLUDED_CCSDS_LDPC_CODE_H
+
+#include <gnuradio/ccsds/api.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief LDPC codes from CCSDS 131.0-B
+     * \ingroup ccsds
+     *
+     * C2 is the (8160,7136) near earth code. The AR4JA deep space codes
+     * are not supported yet. Their permutation tables are needed to add
+     * them; that is a separate request.
+     */
+    enum ldpc_code_t { LDPC_C2 = 0 };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_LDPC_CODE_H */
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CCSDS_LDPC_DECODER_H
+#define INCLUDED_CCSDS_LDPC_DECODER_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/ccsds/ldpc_code.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Decodes CCSDS LDPC codeblocks
+     * \ingroup ccsds
+     *
+     * Takes pdus holding one codeblock following the ASM, as produced by
+     * the correlator, and publishes pdus with the decoded information bytes.
+     * The codeblock is either packed hard bits (u8vector) or one soft symbol
+     * per bit (f32vector or s8vector) where a positive value means one.
+     *
+     * Decoding uses layered normalized min-sum on saturating int8 messages
+     * and stops as soon as all parity checks are satisfied. Codeblocks that
+     * do not satisfy the parity checks after max_iterations are dropped.
+     * The number of iterations used is added to the pdu metadata under the
+     * key "iterations".
+     */
+    class CCSDS_API ldpc_decoder : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<ldpc_decoder> sptr;
+
+      /*!
+       * \brief make the ldpc decoder.
+       *
+       * \param code the ldpc code
+       * \param max_iterations maximum number of decoder iterations
+       * \param descramble remove the CCSDS pseudo randomizer before decoding
+       */
+      static sptr make(ldpc_code_t code=LDPC_C2,
+                       int max_iterations=50,
+                       bool descramble=true);
+
+      /*!
+       * \brief number of codeblocks that were decoded
+       */
+      virtual uint64_t num_frames_decoded() const = 0;
+
+      /*!
+       * \brief number of codeblocks that failed to decode
+       */
+      virtual uint64_t num_frames_failed() const = 0;
+
+      /*!
+       * \brief average number of iterations used per codeblock
+       */
+      virtual float average_iterations() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_LDPC_DECODER_H */
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_LDPC_ENCODER_H
+#define INCLUDED_CCSDS_LDPC_ENCODER_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/ccsds/ldpc_code.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Create LDPC encoded CCSDS frames
+     * \ingroup ccsds
+     *
+     * Encodes one codeblock worth of information bytes per pdu (or tagged
+     * stream packet) and outputs the ASM followed by the codeblock, in the
+     * same way as the ccsds encoder does for Reed Solomon frames.
+     *
+     * The parity bits are computed from the quasi-cyclic generator of the
+     * code, one cyclically shifted generator row per information bit.
+     * Only C2 is available. AR4JA encoding follows once ldpc_code_t has
+     * the AR4JA codes.
+     */
+    class CCSDS_API ldpc_encoder : virtual public gr::tagged_stream_block
+    {
+     public:
+      typedef std::shared_ptr<ldpc_encoder> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of ccsds::ldpc_encoder.
+       *
+       * \param itemsize 0 for pdu input, otherwise the input item size
+       * \param len_tag_key length tag key of the tagged stream input
+       * \param code the ldpc code
+       * \param scramble apply the CCSDS pseudo randomizer to the codeblock
+       * \param printing print every codeblock
+       * \param verbose print frame counts
+       */
+      static sptr make(size_t itemsize=0, const std::string& len_tag_key="packet_len", ldpc_code_t code=LDPC_C2, bool scramble=true, bool printing=false, bool verbose=false);
+
+      /*!
+       * \brief return the number of frames sent
+       *
+       */
+      virtual uint32_t num_frames() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_LDPC_ENCODER_H */
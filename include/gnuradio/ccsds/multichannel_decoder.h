@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CCSDS_MULTICHANNEL_DECODER_H
+#define INCLUDED_CCSDS_MULTICHANNEL_DECODER_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Decodes Reed Solomon encoded CCSDS frames from several bit streams
+     * \ingroup ccsds
+     *
+     * Works like one ccsds_decoder per input, with one stream of unpacked
+     * bits per channel. The sync word search runs per channel in the
+     * scheduler thread. Codewords are decoded by one pool of n_threads
+     * threads shared by all channels, so a busy channel can use the
+     * threads an idle one leaves free.
+     *
+     * Every sync word candidate opens a codeword when rs_decode is set,
+     * also inside an earlier codeword of the same channel, and codewords
+     * with an uncorrectable first rs block are dropped as false locks.
+     * The pdus carry the index of their input under "channel" in the
+     * metadata, and are published in the order their codewords ended.
+     *
+     * nrzm, asm_, asm_mask, rs_e, virtual_fill, check_fecf and
+     * drop_fecf_errors work as for the ccsds_decoder, and apply to every
+     * channel. There is no slip window: with rs_decode set every sync
+     * word is tried wherever it is, so a slipped one is found anyway.
+     * The settings are fixed when the block is made, there are no setters
+     * or config port.
+     */
+    class CCSDS_API multichannel_decoder : virtual public gr::sync_block
+    {
+     public:
+      typedef std::shared_ptr<multichannel_decoder> sptr;
+
+      /*!
+       * \brief make the multichannel decoder.
+       *
+       * \param n_channels number of input bit streams
+       * \param threshold maximum number of wrong bits in the sync word
+       * \param rs_decode decode the rs blocks
+       * \param descramble remove the CCSDS pseudo randomizer
+       * \param deinterleave deinterleave the rs blocks
+       * \param n_interleave rs interleaving depth
+       * \param dual_basis use the dual basis representation
+       * \param n_threads number of decoding threads, 0 for one per core
+       * \param nrzm decode NRZ-M coded input
+       * \param asm_ attached sync marker, last bit in the lsb
+       * \param asm_mask mask of the attached sync marker bits
+       * \param rs_e rs error correction capability, 16 or 8
+       * \param virtual_fill number of virtual fill symbols per rs block
+       * \param check_fecf check the frame error control field
+       * \param drop_fecf_errors drop frames with a wrong frame error control field
+       */
+      static sptr make(int n_channels=2,
+                       int threshold=0,
+                       bool rs_decode=true,
+                       bool descramble=true,
+                       bool deinterleave=true,
+                       int n_interleave=5,
+                       bool dual_basis=true,
+                       int n_threads=0,
+                       bool nrzm=false,
+                       uint64_t asm_=0x1acffc1d,
+                       uint64_t asm_mask=0xffffffff,
+                       int rs_e=16,
+                       int virtual_fill=0,
+                       bool check_fecf=false,
+                       bool drop_fecf_errors=false);
+
+      /*!
+       * \brief return number of received frames on a channel
+       */
+      virtual uint64_t num_frames_received(int channel) const = 0;
+      /*!
+       * \brief return number of decoded frames on a channel
+       */
+      virtual uint64_t num_frames_decoded(int channel) const = 0;
+      /*!
+       * \brief return number of false locks on a channel
+       */
+      virtual uint64_t num_false_locks(int channel) const = 0;
+      /*!
+       * \brief return number of frames with a wrong frame error control field on a channel
+       */
+      virtual uint64_t num_fecf_errors(int channel) const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_MULTICHANNEL_DECODER_H */
@@ -0,0 +1,41 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef INCLUDED_CCSDS_OUTPUT_FORMAT_H
+#define INCLUDED_CCSDS_OUTPUT_FORMAT_H
+
+#include <gnuradio/ccsds/api.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Representation of the encoded bits on an encoder output
+     * \ingroup ccsds
+     *
+     * OUTPUT_PACKED gives bytes of 8 bits, most significant bit first.
+     * OUTPUT_UNPACKED gives one bit per byte. OUTPUT_SOFT gives one float
+     * per bit, +1 for a one and -1 for a zero.
+     */
+    enum output_format_t { OUTPUT_PACKED = 0, OUTPUT_UNPACKED = 1, OUTPUT_SOFT = 2 };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_OUTPUT_FORMAT_H */
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_PACKET_EXTRACTOR_H
+#define INCLUDED_CCSDS_PACKET_EXTRACTOR_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/block.h>
+#include <vector>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Extracts space packets from transfer frames
+     * \ingroup ccsds
+     *
+     * Takes pdus holding one TM or AOS transfer frame each and publishes
+     * the space packets carried in their data fields, following the first
+     * header pointer. Packets that continue into later frames are put
+     * together per virtual channel. A break in the virtual channel frame
+     * count drops the packet being put together, and the channel picks up
+     * again at the next first header pointer.
+     *
+     * TM frames may have a secondary header and an operational control
+     * field as flagged in their primary header. AOS frames are taken to
+     * carry an M_PDU with no insert zone, frame header error control or
+     * operational control field. Set fecf if the frames end in a frame
+     * error control field.
+     *
+     * A packet with the APID apids[i] is published on port apid<i>, and
+     * other packets on port out. Idle packets are dropped.
+     */
+    class CCSDS_API packet_extractor : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<packet_extractor> sptr;
+
+      /*!
+       * \brief make the packet extractor.
+       *
+       * \param apids APID for each apid<i> output port
+       * \param fecf the frames end in a frame error control field
+       */
+      static sptr make(const std::vector<int> &apids=std::vector<int>(),
+                       bool fecf=false);
+
+      /*!
+       * \brief number of packets published with an APID
+       */
+      virtual uint64_t num_packets(int apid) const = 0;
+
+      /*!
+       * \brief number of packets dropped unfinished or malformed
+       */
+      virtual uint64_t num_packets_dropped() const = 0;
+
+      /*!
+       * \brief number of pdus that were not TM or AOS frames
+       */
+      virtual uint64_t num_frames_dropped() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_PACKET_EXTRACTOR_H */
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_SOFT_CORRELATOR_H
+#define INCLUDED_CCSDS_SOFT_CORRELATOR_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief CCSDS soft decision correlator
+     * \ingroup ccsds
+     *
+     * looks for the attached sync marker in a stream of soft symbols (float
+     * or int8, a positive value means one) and produces pdus containing the
+     * soft symbols of the frames, as f32vector or s8vector.
+     *
+     * The symbols are correlated against the ASM mapped to +-1. The
+     * detection threshold adapts to the input: the signal amplitude and
+     * the noise power are estimated as the search advances from running
+     * means of x^2 and x^4, and the ASM is detected when the magnitude of
+     * the correlation reaches threshold times asm_len times the amplitude.
+     * The threshold is kept at least 2.5 times the rms correlation seen
+     * away from the ASM, so noise alone rarely triggers it. The strongest
+     * of the first window over the threshold and the asm_len - 1 after it
+     * is taken as the ASM, so a window that only partly covers the ASM
+     * does not misalign the frame. A negative correlation means inverted
+     * symbols, which are corrected before the frame is published.
+     */
+    class CCSDS_API soft_correlator : virtual public gr::sync_block
+    {
+     public:
+      typedef std::shared_ptr<soft_correlator> sptr;
+
+      /*!
+       * \brief make the soft correlator.
+       *
+       * \param itemsize size of the input symbols, sizeof(float) or sizeof(int8_t)
+       * \param asm_ attached sync marker, last bit in the lsb
+       * \param asm_len length of the attached sync marker in bits
+       * \param threshold detection threshold relative to the expected correlation of the ASM (0..1)
+       * \param frame_len length of the frame following the ASM in bytes
+       */
+      static sptr make(size_t itemsize=sizeof(float),
+                       const uint64_t asm_=0x1acffc1d,
+                       const int asm_len=32,
+                       const float threshold=0.6,
+                       const size_t frame_len=223);
+
+      /*!
+       * \brief number of frames detected
+       */
+      virtual uint64_t frame_count() const = 0;
+
+      /*!
+       * \brief running estimate of the signal to noise power ratio of the input
+       */
+      virtual float snr() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_SOFT_CORRELATOR_H */
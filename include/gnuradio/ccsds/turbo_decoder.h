@@ -0,0 +1,89 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_TURBO_DECODER_H
+#define INCLUDED_CCSDS_TURBO_DECODER_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Decodes CCSDS turbo codeblocks
+     * \ingroup ccsds
+     *
+     * Takes pdus holding the soft symbols of one codeblock following the
+     * ASM (f32vector or s8vector, a positive value means one) and
+     * publishes pdus with the decoded information bytes.
+     *
+     * Decoding uses max-log-MAP component decoders and stops when the hard
+     * decisions no longer change between iterations, or when the trailing
+     * CRC-16 of the information block (the frame error control field of a
+     * transfer frame) is correct if check_crc is set. Codeblocks that do
+     * not converge, or fail the CRC check, are dropped. The number of
+     * iterations used is added to the pdu metadata under "iterations".
+     *
+     * Codeblocks are decoded concurrently on n_threads threads and
+     * published in the order they were received.
+     */
+    class CCSDS_API turbo_decoder : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<turbo_decoder> sptr;
+
+      /*!
+       * \brief make the turbo decoder.
+       *
+       * \param info_len information block length in bits: 1784, 3568, 7136 or 8920
+       * \param rate inverse code rate: 2, 3, 4 or 6
+       * \param max_iterations maximum number of decoder iterations
+       * \param check_crc stop on and require a correct CRC-16 at the end of the block
+       * \param descramble remove the CCSDS pseudo randomizer before decoding
+       * \param n_threads number of decoding threads, 0 for one per core
+       */
+      static sptr make(int info_len=1784,
+                       int rate=2,
+                       int max_iterations=10,
+                       bool check_crc=false,
+                       bool descramble=true,
+                       int n_threads=1);
+
+      /*!
+       * \brief number of codeblocks that were decoded
+       */
+      virtual uint64_t num_frames_decoded() const = 0;
+
+      /*!
+       * \brief number of codeblocks that failed to decode
+       */
+      virtual uint64_t num_frames_failed() const = 0;
+
+      /*!
+       * \brief average number of iterations used per codeblock
+       */
+      virtual float average_iterations() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_TURBO_DECODER_H */
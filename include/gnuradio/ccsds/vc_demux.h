@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_VC_DEMUX_H
+#define INCLUDED_CCSDS_VC_DEMUX_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/block.h>
+#include <vector>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Routes transfer frames to a message port per virtual channel
+     * \ingroup ccsds
+     *
+     * Takes pdus holding one TM or AOS transfer frame each, as published by
+     * the decoders, and reads the version, spacecraft id, virtual channel
+     * id and virtual channel frame count from the primary header. A frame
+     * with the virtual channel id vcids[i] is passed on unchanged on port
+     * out<i>. Frames of other virtual channels or spacecraft, and frames
+     * that are not TM or AOS, are dropped and counted.
+     *
+     * The frame count of each virtual channel is followed, and a count
+     * that does not follow the previous one is counted as a gap, with the
+     * frames skipped counted as lost.
+     */
+    class CCSDS_API vc_demux : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<vc_demux> sptr;
+
+      /*!
+       * \brief make the virtual channel demux.
+       *
+       * \param vcids virtual channel id for each output port
+       * \param scid spacecraft id to accept, or -1 for any
+       */
+      static sptr make(const std::vector<int> &vcids=std::vector<int>(1, 0),
+                       int scid=-1);
+
+      /*!
+       * \brief number of frames received on a virtual channel
+       */
+      virtual uint64_t num_frames(int vcid) const = 0;
+
+      /*!
+       * \brief number of breaks in the frame count of a virtual channel
+       */
+      virtual uint64_t num_gaps(int vcid) const = 0;
+
+      /*!
+       * \brief number of frames missing from a virtual channel
+       */
+      virtual uint64_t num_lost_frames(int vcid) const = 0;
+
+      /*!
+       * \brief number of frames that were not routed to a port
+       */
+      virtual uint64_t num_frames_dropped() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_VC_DEMUX_H */
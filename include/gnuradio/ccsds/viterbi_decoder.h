@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CCSDS_VITERBI_DECODER_H
+#define INCLUDED_CCSDS_VITERBI_DECODER_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace ccsds {
+
+    /*!
+     * \brief Multi-threaded viterbi decoder for the CCSDS rate 1/2 convolutional code
+     * \ingroup ccsds
+     *
+     * Takes pairs of soft symbols (positive means one) and produces one
+     * unpacked bit per pair, ready for the ccsds_decoder or correlator.
+     *
+     * The stream is split into segments of segment_len bits which are
+     * decoded independently on a pool of n_threads threads. Each segment is
+     * decoded together with margin bits on both sides for training and
+     * traceback, so the output only depends on the segmentation and not on
+     * the number of threads.
+     */
+    class CCSDS_API viterbi_decoder : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<viterbi_decoder> sptr;
+
+      /*!
+       * \brief make the viterbi decoder.
+       *
+       * \param n_threads number of decoding threads, 0 for one per core
+       * \param segment_len number of bits decoded per segment
+       * \param margin training and traceback margin in bits on each side of a segment
+       * \param invert_g2 invert the second symbol as done by CCSDS
+       */
+      static sptr make(int n_threads=0,
+                       int segment_len=8192,
+                       int margin=96,
+                       bool invert_g2=true);
+
+      /*!
+       * \brief number of segments decoded
+       */
+      virtual uint64_t num_segments() const = 0;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_VITERBI_DECODER_H */
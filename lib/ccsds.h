@@ -24,9 +24,14 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
 
 // reed solomon(233,255) constants
 #define RS_BITS_PER_SYM 8
+#define RS_NN 255
+#define RS_E 16 // symbol errors corrected per block by default
+#define RS_E_MIN 8
 #define RS_DATA_LEN 223
 #define RS_PARITY_LEN 32
 #define RS_BLOCK_LEN (RS_DATA_LEN + RS_PARITY_LEN)
@@ -39,8 +44,11 @@
 #define SYNC_WORD_LEN 4
 //#define SYNC_WORD 0x1acffc1d
 #define SCRAMBLER_POLY_LEN 255
-#define DATA_MAX_LEN (RS_DATA_LEN * RS_MAX_NBLOCKS)
+#define DATA_MAX_LEN ((RS_NN - 2*RS_E_MIN) * RS_MAX_NBLOCKS)
 #define CODEWORD_MAX_LEN (RS_BLOCK_LEN * RS_MAX_NBLOCKS)
+// frames of output buffer the encoders ask for, so that the blocks after
+// them are called with several frames at a time
+#define OUTPUT_BUFFER_FRAMES 16
 //#define TOTAL_FRAME_LEN (SYNC_WORD_LEN + CODEWORD_LEN)
 
 struct ccsds_tx_pkt {
@@ -103,5 +111,193 @@ inline void descramble(uint8_t *data, uint32_t length) {
     // self inverse function
     scramble(data, length);
 }
+// pack nbytes bytes from 8*nbytes bytes holding one bit each in their lsb,
+// first bit in the msb. the bits are inverted if invert is set.
+inline void pack_bits(const uint8_t *in, uint8_t *out, size_t nbytes, bool invert) {
+    const uint8_t x = invert ? 0xff : 0x00;
+    for (size_t i=0; i<nbytes; i++) {
+        uint64_t v;
+        memcpy(&v, &in[8*i], 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        v = __builtin_bswap64(v);
+#endif
+        // the multiply gathers the lsb of byte k into bit 63-k without carries
+        out[i] = (uint8_t)(((v & 0x0101010101010101ULL) * 0x8040201008040201ULL) >> 56) ^ x;
+    }
+}
+
+// nrz-m decode nbytes of packed bits in place: each bit becomes its xor
+// with the bit before it. last is the raw bit before the first one, and
+// the raw bit after the last one is returned.
+inline uint8_t nrzm_decode(uint8_t *data, size_t nbytes, uint8_t last) {
+    size_t i = 0;
+    for (; i+8<=nbytes; i+=8) {
+        uint64_t w;
+        memcpy(&w, &data[i], 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        w = __builtin_bswap64(w);
+#endif
+        const uint64_t d = w ^ ((w >> 1) | ((uint64_t)last << 63));
+        last = w & 0x01;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        const uint64_t out = __builtin_bswap64(d);
+#else
+        const uint64_t out = d;
+#endif
+        memcpy(&data[i], &out, 8);
+    }
+    for (; i<nbytes; i++) {
+        const uint8_t b = data[i];
+        data[i] = b ^ ((b >> 1) | (last << 7));
+        last = b & 0x01;
+    }
+    return last;
+}
+
+// the last 128 input bits with the newest bit in the lsb of lo, used to look
+// back for a sync marker that arrived a few bits early or late
+struct bit_history {
+    uint64_t hi, lo;
+
+    void clear() { hi = 0; lo = 0; }
+    void push(uint8_t bit) {
+        hi = (hi << 1) | (lo >> 63);
+        lo = (lo << 1) | (bit & 0x01);
+    }
+    // push 8 packed bits, first bit in the msb
+    void push_byte(uint8_t byte) {
+        hi = (hi << 8) | (lo >> 56);
+        lo = (lo << 8) | byte;
+    }
+    // the 64 bits ending shift bits before the newest bit, shift <= 64
+    uint64_t window(int shift) const {
+        if (shift == 0) return lo;
+        if (shift == 64) return hi;
+        return (lo >> shift) | (hi << (64 - shift));
+    }
+};
+
+// the slip window is limited by the history and a 64 bit sync marker
+#define MAX_SLIP_WINDOW 32
+
+// TM transfer frame primary header, CCSDS 132.0-B
+#define TM_PRIMARY_HEADER_LEN 6
+#define TM_FHP_NO_PACKET 0x7ff  // no packet starts in the data field
+#define TM_FHP_IDLE 0x7fe       // the data field holds only idle data
+#define TM_IDLE_VCID 7          // virtual channel used for idle frames
+#define TM_IDLE_PATTERN 0x55
+
+inline void tm_primary_header(uint8_t *h, uint16_t scid, uint8_t vcid,
+                              uint8_t mc_count, uint8_t vc_count, uint16_t fhp) {
+    // version 00, no operational control field, no secondary header, no
+    // packet order or segment length (11), synchronous flag clear
+    h[0] = (scid >> 4) & 0x3f;
+    h[1] = ((scid & 0x0f) << 4) | ((vcid & 0x07) << 1);
+    h[2] = mc_count;
+    h[3] = vc_count;
+    h[4] = 0x18 | ((fhp >> 8) & 0x07);
+    h[5] = fhp & 0xff;
+}
+
+// transfer frame version numbers, TM (CCSDS 132.0-B) and AOS (CCSDS 732.0-B)
+#define TM_VERSION 0
+#define AOS_VERSION 1
+#define AOS_PRIMARY_HEADER_LEN 6
+#define MAX_VCIDS 64 // aos virtual channel ids are six bits
+#define TM_OCF_LEN 4
+#define AOS_MPDU_HEADER_LEN 2
+
+struct frame_header {
+    uint8_t version;
+    uint16_t scid;
+    uint8_t vcid;
+    uint32_t vc_count;
+    uint32_t vc_count_mod; // the virtual channel frame count wraps here
+};
+
+// read the ids and virtual channel frame count from the primary header of
+// a TM or AOS transfer frame. returns false if the frame is too short or
+// of another version.
+inline bool parse_frame_header(const uint8_t *h, size_t len, frame_header &fh) {
+    if (len < TM_PRIMARY_HEADER_LEN) return false;
+    fh.version = h[0] >> 6;
+    if (fh.version == TM_VERSION) {
+        fh.scid = ((h[0] & 0x3f) << 4) | (h[1] >> 4);
+        fh.vcid = (h[1] >> 1) & 0x07;
+        fh.vc_count = h[3];
+        fh.vc_count_mod = 1 << 8;
+        return true;
+    }
+    if (fh.version == AOS_VERSION) {
+        fh.scid = ((h[0] & 0x3f) << 2) | (h[1] >> 6);
+        fh.vcid = h[1] & 0x3f;
+        fh.vc_count = (h[2] << 16) | (h[3] << 8) | h[4];
+        fh.vc_count_mod = 1 << 24;
+        return true;
+    }
+    return false;
+}
+
+// space packet primary header, CCSDS 133.0-B
+#define SPACE_PACKET_HEADER_LEN 6
+#define SPACE_PACKET_MIN_LEN 7
+#define SPACE_PACKET_IDLE_APID 0x7ff
+#define SPACE_PACKET_NUM_APIDS 2048
+
+inline void space_packet_header(uint8_t *h, uint16_t apid, uint16_t count, size_t len) {
+    // version 000, telemetry, no secondary header, unsegmented
+    h[0] = (apid >> 8) & 0x07;
+    h[1] = apid & 0xff;
+    h[2] = 0xc0 | ((count >> 8) & 0x3f);
+    h[3] = count & 0xff;
+    h[4] = ((len - SPACE_PACKET_HEADER_LEN - 1) >> 8) & 0xff;
+    h[5] = (len - SPACE_PACKET_HEADER_LEN - 1) & 0xff;
+}
+
+inline uint16_t space_packet_apid(const uint8_t *h) {
+    return ((h[0] & 0x07) << 8) | h[1];
+}
+
+// total length of a space packet from its header
+inline size_t space_packet_len(const uint8_t *h) {
+    return SPACE_PACKET_HEADER_LEN + 1 + ((h[4] << 8) | h[5]);
+}
+
+// pseudo randomizer bit i of a codeblock, for descrambling soft symbols
+inline uint8_t scrambler_bit(uint32_t i) {
+    return (SCRAMBLER_POLY[(i >> 3) % SCRAMBLER_POLY_LEN] >> (7 - (i & 0x07))) & 0x01;
+}
+
+// frame error control field, the crc16 of the rest of the transfer frame
+#define FECF_LEN 2
+
+extern const uint16_t CRC16_TABLE[8][256];
+
+// CRC-16-CCITT (x^16 + x^12 + x^5 + 1, preset to all ones) as used for the
+// frame error control field. the crc over data followed by its crc is zero.
+// eight bytes are taken per step (slicing-by-8): the register is xored into
+// the first two, and each byte is looked up with the zero bytes after it.
+inline uint16_t crc16(const uint8_t *data, uint32_t length) {
+    uint16_t crc = 0xffff;
+    uint32_t i = 0;
+    for (; i+8<=length; i+=8) {
+        crc = CRC16_TABLE[7][data[i] ^ (crc >> 8)] ^
+              CRC16_TABLE[6][data[i+1] ^ (crc & 0xff)] ^
+              CRC16_TABLE[5][data[i+2]] ^ CRC16_TABLE[4][data[i+3]] ^
+              CRC16_TABLE[3][data[i+4]] ^ CRC16_TABLE[2][data[i+5]] ^
+              CRC16_TABLE[1][data[i+6]] ^ CRC16_TABLE[0][data[i+7]];
+    }
+    for (; i<length; i++) {
+        crc = (crc << 8) ^ CRC16_TABLE[0][(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
+// append the fecf over the first len bytes of frame at frame[len]
+inline void append_fecf(uint8_t *frame, uint32_t len) {
+    const uint16_t crc = crc16(frame, len);
+    frame[len] = crc >> 8;
+    frame[len+1] = crc & 0xff;
+}
 
 #endif // __CCSDS_H__
@@ -23,6 +23,7 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include "ccsds_decoder_impl.h"
@@ -31,44 +32,121 @@
 
 #define STATE_SYNC_SEARCH 0
 #define STATE_CODEWORD 1
+#define STATE_RESYNC 2
 
 namespace gr {
   namespace ccsds {
 
     ccsds_decoder::sptr
-    ccsds_decoder::make(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis)
+    ccsds_decoder::make(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis, int slip_window, int queue_depth, bool drop_on_overflow, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors)
     {
       return gnuradio::get_initial_sptr
-        (new ccsds_decoder_impl(threshold, rs_decode, deinterleave, descramble, verbose, printing, n_interleave, dual_basis));
+        (new ccsds_decoder_impl(threshold, rs_decode, deinterleave, descramble, verbose, printing, n_interleave, dual_basis, slip_window, queue_depth, drop_on_overflow, nrzm, asm_, asm_mask, rs_e, virtual_fill, check_fecf, drop_fecf_errors));
     }
 
-    ccsds_decoder_impl::ccsds_decoder_impl(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis)
+    ccsds_decoder_impl::ccsds_decoder_impl(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis, int slip_window, int queue_depth, bool drop_on_overflow, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors)
       : gr::sync_block("ccsds_decoder",
               gr::io_signature::make(1, 1, sizeof(uint8_t)),
               gr::io_signature::make(0, 0, 0)),
-        d_threshold(threshold),
-        d_rs_decode(rs_decode),
-        d_deinterleave(deinterleave),
-        d_descramble(descramble),
         d_verbose(verbose),
         d_printing(printing),
-        d_n_interleave(n_interleave),
-        d_dual_basis(dual_basis),
+        d_slip_window(slip_window),
+        d_queue_depth(queue_depth),
+        d_drop_on_overflow(drop_on_overflow),
+        d_nrzm(nrzm),
+        d_nrzm_last(0),
+        d_asm(asm_),
+        d_asm_mask(asm_mask),
+        d_asm_len(asm_mask ? 64 - __builtin_clzll(asm_mask) : 0),
         d_num_frames_received(0),
         d_num_frames_decoded(0),
-        d_num_subframes_decoded(0)
+        d_num_subframes_decoded(0),
+        d_num_bit_slips(0),
+        d_num_false_locks(0),
+        d_check_fecf(check_fecf),
+        d_drop_fecf_errors(drop_fecf_errors),
+        d_num_fecf_errors(0),
+        d_resync_bits(0),
+        d_written(0),
+        d_pos(0),
+        d_lock_pos(0),
+        d_rs(rs_e, virtual_fill),
+        d_running(false),
+        d_num_frames_dropped(0),
+        d_max_queue_depth(0),
+        d_config_changed(false)
     {
+      if (n_interleave < 1 || n_interleave > RS_MAX_NBLOCKS) {
+          throw std::runtime_error("n_interleave must be between 1 and 8");
+      }
+      if (slip_window < 0 || slip_window > MAX_SLIP_WINDOW) {
+          throw std::runtime_error("slip_window must be between 0 and 32");
+      }
+      if (queue_depth < 0) {
+          throw std::runtime_error("queue_depth must not be negative");
+      }
+      if (asm_mask == 0) {
+          throw std::runtime_error("asm_mask must not be zero");
+      }
+      if (threshold < 0 || threshold >= d_asm_len) {
+          throw std::runtime_error("threshold must be between 0 and the asm length - 1");
+      }
+      if (queue_depth > 0) {
+          d_queue.reset(new spsc_ring<codeword_slot>(queue_depth));
+      }
+
+      d_cfg.threshold = threshold;
+      d_cfg.rs_decode = rs_decode;
+      d_cfg.deinterleave = deinterleave;
+      d_cfg.descramble = descramble;
+      d_cfg.n_interleave = n_interleave;
+      d_cfg.dual_basis = dual_basis;
+      d_pending_cfg = d_cfg;
+
       message_port_register_out(pmt::mp("out"));
+      message_port_register_in(pmt::mp("config"));
+      set_msg_handler(pmt::mp("config"), [this](pmt::pmt_t msg) { this->handle_config(msg); });
+      d_history.clear();
+      d_search_reg = 0;
 
-      for (uint8_t i=0; i<SYNC_WORD_LEN; i++) {
-          d_sync_word = (d_sync_word << 8) | (SYNC_WORD[i] & 0xff);
+      // room for a failed frame and the one following it, at any
+      // interleaving depth set later
+      const int max_frame_bits = d_asm_len + 8*CODEWORD_MAX_LEN;
+      size_t ring_len = 1;
+      while (ring_len < (size_t)(2*max_frame_bits + d_asm_len + 2*MAX_SLIP_WINDOW)) {
+          ring_len <<= 1;
       }
+      d_ring.resize(ring_len);
+      d_ring_mask = ring_len - 1;
 
       enter_sync_search();
     }
 
     ccsds_decoder_impl::~ccsds_decoder_impl()
     {
+        stop();
+    }
+
+    bool ccsds_decoder_impl::start()
+    {
+        if (d_queue && !d_running) {
+            d_running = true;
+            d_decode_thread = std::thread(&ccsds_decoder_impl::decode_loop, this);
+        }
+        return true;
+    }
+
+    bool ccsds_decoder_impl::stop()
+    {
+        // the decode thread empties the queue before it exits
+        {
+            std::lock_guard<std::mutex> lock(d_queue_mutex);
+            d_running = false;
+        }
+        d_data_cond.notify_all();
+        d_space_cond.notify_all();
+        if (d_decode_thread.joinable()) d_decode_thread.join();
+        return true;
     }
 
     int
@@ -78,52 +156,176 @@ namespace gr {
     {
       const uint8_t *in = (const uint8_t *) input_items[0];
 
-      uint16_t count = 0;
-      while (count < noutput_items) {
-          switch (d_decoder_state) {
-              case STATE_SYNC_SEARCH:
-                  // get next bit
-                  d_data_reg = (d_data_reg << 1) | (in[count++] & 0x01);
-                  if (compare_sync_word()) {
-                      if (d_verbose) printf("\tsync word detected\n");
-                      d_num_frames_received++;
-                      enter_codeword();
-                  }
-                  break;
-              case STATE_CODEWORD:
-                  // get next bit and pack then into full bytes
-                  d_data_reg = (d_data_reg << 1) | (in[count++] & 0x01);
-                  d_bit_counter++;
-                  if (d_bit_counter == 8) {
-                      d_codeword[d_byte_counter] = d_data_reg;
-                      d_byte_counter++;
-                      d_bit_counter = 0;
-                  }
-                  // once the full codeword is loaded, try to decode the packet
-                  if (d_byte_counter == codeword_len()) {
-                      if (d_verbose) printf("\tloaded codeword of length %i\n", codeword_len());
-                      if (d_printing) print_bytes(d_codeword, codeword_len());
-
-                      bool success = decode_frame();
-                      if (success) {
-                          pmt::pmt_t pdu(pmt::cons(pmt::PMT_NIL, pmt::make_blob(d_payload, data_len())));
-                          message_port_pub(pmt::mp("out"), pdu);
-                      }
+      for (int i=0; i<noutput_items; i++) {
+          uint8_t bit = in[i] & 0x01;
+          if (d_nrzm) {
+              // a change of level is a one
+              const uint8_t raw = bit;
+              bit ^= d_nrzm_last;
+              d_nrzm_last = raw;
+          }
+          d_ring[d_written & d_ring_mask] = bit;
+          d_written++;
 
-                      if (d_verbose) {
-                          printf("\tframes received: %i\n\tframes decoded: %i\n\tsubframes decoded: %i\n",
-                                  d_num_frames_received,
-                                  d_num_frames_decoded,
-                                  d_num_subframes_decoded);
+          // sync words are searched for in every bit, also while a codeword
+          // is being read, so that a false lock does not hide a real frame
+          d_search_reg = (d_search_reg << 1) | bit;
+          if (compare_sync_word(d_search_reg)) {
+              d_candidates.push_back(d_written);
+          }
+
+          // the decoder lags behind the input after going back to an
+          // earlier candidate, and catches up from the ring
+          while (d_pos < d_written) {
+              switch (d_decoder_state) {
+                  case STATE_SYNC_SEARCH:
+                      apply_config();
+                      drop_candidates(d_pos);
+                      if (d_candidates.empty()) {
+                          d_pos = d_written;
+                      } else {
+                          lock(d_candidates.front());
                       }
-                      enter_sync_search();
+                      break;
+                  case STATE_CODEWORD: {
+                      const uint8_t b = d_ring[d_pos++ & d_ring_mask];
+                      d_history.push(b);
+                      if (add_codeword_bit(b)) {
+                          end_codeword();
+                      }
+                      break;
                   }
-                  break;
+                  case STATE_RESYNC:
+                      // read up to the latest possible end of the next sync word
+                      d_history.push(d_ring[d_pos++ & d_ring_mask]);
+                      d_resync_bits++;
+                      if (d_resync_bits == d_asm_len + d_slip_window) {
+                          resync();
+                      }
+                      break;
+              }
           }
       }
       return noutput_items;
     }
 
+    void
+    ccsds_decoder_impl::lock(uint64_t pos)
+    {
+        if (d_verbose) printf("\tsync word detected\n");
+        d_num_frames_received++;
+        d_pos = pos;
+        d_lock_pos = pos;
+        drop_candidates(pos + 1);
+        enter_codeword();
+    }
+
+    void
+    ccsds_decoder_impl::drop_candidates(uint64_t pos)
+    {
+        // forget candidates before pos
+        while (!d_candidates.empty() && d_candidates.front() < pos) {
+            d_candidates.pop_front();
+        }
+    }
+
+    bool
+    ccsds_decoder_impl::add_codeword_bit(uint8_t bit)
+    {
+        // pack bits into full bytes
+        d_data_reg = (d_data_reg << 1) | bit;
+        d_bit_counter++;
+        if (d_bit_counter == 8) {
+            d_codeword[d_byte_counter] = d_data_reg;
+            d_byte_counter++;
+            d_bit_counter = 0;
+        }
+        return d_byte_counter == codeword_len();
+    }
+
+    void
+    ccsds_decoder_impl::end_codeword()
+    {
+        // once the full codeword is loaded, try to decode the packet
+        if (d_verbose) printf("\tloaded codeword of length %i\n", codeword_len());
+        if (d_printing) print_bytes(d_codeword, codeword_len());
+
+        bool success = true;
+        if (d_queue) {
+            // the frame is decoded on the decode thread, so it is taken as
+            // locked and not retried from an earlier sync word if it fails
+            queue_codeword();
+        } else {
+            success = decode_frame(d_codeword, d_payload, d_cfg);
+            if (success) publish_frame(d_payload, data_len());
+
+            if (d_verbose) {
+                printf("\tframes received: %i\n\tframes decoded: %i\n\tsubframes decoded: %i\n\tfalse locks: %i\n",
+                        d_num_frames_received,
+                        d_num_frames_decoded.load(),
+                        d_num_subframes_decoded.load(),
+                        d_num_false_locks.load());
+            }
+        }
+
+        apply_config();
+        if (!success) {
+            // the lock may have been false. go back and try the candidates
+            // found inside the failed codeword.
+            if (d_verbose && !d_candidates.empty()) printf("\tretrying from an earlier sync word\n");
+            d_pos = d_lock_pos;
+            enter_sync_search();
+        } else if (d_slip_window > 0) {
+            drop_candidates(d_pos);
+            enter_resync();
+        } else {
+            drop_candidates(d_pos);
+            enter_sync_search();
+        }
+    }
+
+    void
+    ccsds_decoder_impl::resync()
+    {
+        // the history ends slip_window bits after the expected end of the
+        // sync word. take the offset with the fewest errors, and the
+        // smallest slip among those.
+        const int n = d_slip_window;
+        int best_slip = 0;
+        uint64_t best_errors = UINT64_MAX;
+        for (int slip=-n; slip<=n; slip++) {
+            uint64_t nwrong = 0;
+            volk_64u_popcnt(&nwrong, (d_history.window(n - slip) ^ d_asm) & d_asm_mask);
+            if (nwrong < best_errors || (nwrong == best_errors && abs(slip) < abs(best_slip))) {
+                best_errors = nwrong;
+                best_slip = slip;
+            }
+        }
+
+        if (best_errors > (uint64_t)d_cfg.threshold) {
+            // lost lock, search from the end of the previous frame
+            d_pos -= d_resync_bits;
+            enter_sync_search();
+            return;
+        }
+
+        if (best_slip != 0) {
+            if (d_verbose) printf("\tsync word slipped by %i bits\n", best_slip);
+            d_num_bit_slips++;
+        }
+
+        // the bits read past the sync word are read again as codeword
+        lock(d_pos - (n - best_slip));
+    }
+
+    void
+    ccsds_decoder_impl::enter_resync()
+    {
+        if (d_verbose) printf("enter resync\n");
+        d_decoder_state = STATE_RESYNC;
+        d_resync_bits = 0;
+    }
+
     void
     ccsds_decoder_impl::enter_sync_search()
     {
@@ -139,58 +341,202 @@ namespace gr {
         d_byte_counter = 0;
         d_bit_counter = 0;
     }
-    bool ccsds_decoder_impl::compare_sync_word()
+    bool ccsds_decoder_impl::compare_sync_word(uint64_t reg)
     {
-        uint32_t nwrong = 0;
-        uint32_t wrong_bits = d_data_reg ^ d_sync_word;
-        volk_32u_popcnt(&nwrong, wrong_bits);
-        return nwrong <= d_threshold;
+        uint64_t nwrong = 0;
+        const uint64_t wrong_bits = (reg ^ d_asm) & d_asm_mask;
+        volk_64u_popcnt(&nwrong, wrong_bits);
+        return nwrong <= (uint64_t)d_cfg.threshold;
     }
 
-    bool ccsds_decoder_impl::decode_frame()
+    bool ccsds_decoder_impl::decode_frame(const uint8_t *codeword, uint8_t *payload, const frame_config &cfg)
     {
-        // this will be set to false if a codeword is not decodable
-        bool success = true;
-
-        if (d_descramble) {
-            descramble(d_codeword, codeword_len());
+        int nerrors;
+        const int ndecoded = d_rs.decode_codeword(codeword, payload, cfg.n_interleave,
+                                                  cfg.deinterleave, cfg.descramble, cfg.rs_decode,
+                                                  cfg.dual_basis, nerrors);
+        if (ndecoded == -1) {
+            // a codeword after a real sync word rarely has an uncorrectable
+            // first block, give up on this lock
+            if (d_verbose) printf("\tfalse lock\n");
+            d_num_false_locks++;
+            return false;
+        }
+        if (cfg.rs_decode) {
+            if (d_verbose) printf("\tdecoded %i of %i rs blocks with %i errors\n", ndecoded, cfg.n_interleave, nerrors);
+            d_num_subframes_decoded += ndecoded;
         }
 
-        // deinterleave and decode rs blocks
-        uint8_t rs_block[RS_BLOCK_LEN];
-        int8_t nerrors;
-        for (uint8_t i=0; i<d_n_interleave; i++) {
-            for (uint8_t j=0; j<RS_BLOCK_LEN; j++) {
+        // this will be false if a codeword is not decodable
+        const bool success = ndecoded == cfg.n_interleave;
+        if (success) d_num_frames_decoded++;
 
-                if (d_deinterleave) {
-                    rs_block[j] = d_codeword[i+(j*d_n_interleave)];
-                } else {
-                    rs_block[j] = d_codeword[i*RS_BLOCK_LEN + j];
-                }
+        return success;
+    }
 
+    void ccsds_decoder_impl::publish_frame(const uint8_t *payload, int len)
+    {
+        pmt::pmt_t meta = pmt::PMT_NIL;
+        if (d_check_fecf) {
+            // the crc over a frame that ends in its fecf is zero
+            const bool fecf_ok = crc16(payload, len) == 0;
+            if (!fecf_ok) {
+                if (d_verbose) printf("\tfecf error\n");
+                d_num_fecf_errors++;
+                if (d_drop_fecf_errors) return;
             }
-            if (d_rs_decode) {
-                nerrors = d_rs.decode(rs_block, d_dual_basis);
-                if (nerrors == -1) {
-                    if (d_verbose) printf("\tcould not decode rs block #%i\n", i);
-                    success = false;
-                } else {
-                    if (d_verbose) printf("\tdecoded rs block #%i with %i errors\n", i, nerrors);
-                    d_num_subframes_decoded++;
-                }
+            meta = pmt::dict_add(pmt::make_dict(), pmt::mp("fecf_ok"), pmt::from_bool(fecf_ok));
+        }
+        pmt::pmt_t pdu(pmt::cons(meta, pmt::make_blob(payload, len)));
+        message_port_pub(pmt::mp("out"), pdu);
+    }
+
+    void ccsds_decoder_impl::queue_codeword()
+    {
+        codeword_slot *slot = d_queue->write_slot();
+        if (!slot && !d_drop_on_overflow) {
+            std::unique_lock<std::mutex> lock(d_queue_mutex);
+            d_space_cond.wait(lock, [this, &slot] {
+                return (slot = d_queue->write_slot()) != nullptr || !d_running;
+            });
+        }
+        if (!slot) {
+            if (d_verbose) printf("\tdecode queue full, dropped frame\n");
+            d_num_frames_dropped++;
+            return;
+        }
+
+        slot->cfg = d_cfg;
+        memcpy(slot->data, d_codeword, codeword_len());
+        d_queue->push();
+
+        const uint32_t depth = d_queue->size();
+        if (depth > d_max_queue_depth) d_max_queue_depth = depth;
+
+        std::lock_guard<std::mutex> lock(d_queue_mutex);
+        d_data_cond.notify_one();
+    }
+
+    void ccsds_decoder_impl::decode_loop()
+    {
+        std::vector<uint8_t> payload(DATA_MAX_LEN);
+        while (true) {
+            codeword_slot *slot = d_queue->read_slot();
+            if (!slot) {
+                std::unique_lock<std::mutex> lock(d_queue_mutex);
+                d_data_cond.wait(lock, [this, &slot] {
+                    return (slot = d_queue->read_slot()) != nullptr || !d_running;
+                });
+                if (!slot) return;
             }
-            if (d_deinterleave) {
-                for (uint8_t j=0; j<RS_DATA_LEN; j++) {
-                    d_payload[i+(j*d_n_interleave)] = rs_block[j];
-                }
-            } else {
-                memcpy(&d_payload[i*RS_DATA_LEN], rs_block, RS_DATA_LEN);
+
+            const frame_config cfg = slot->cfg;
+            const bool success = decode_frame(slot->data, payload.data(), cfg);
+            d_queue->pop();
+            {
+                std::lock_guard<std::mutex> lock(d_queue_mutex);
+                d_space_cond.notify_one();
             }
+            if (success) publish_frame(payload.data(), d_rs.data_len() * cfg.n_interleave);
         }
+    }
+    void ccsds_decoder_impl::set_threshold(int threshold)
+    {
+        if (threshold < 0 || threshold >= d_asm_len) {
+            throw std::runtime_error("threshold must be between 0 and the asm length - 1");
+        }
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.threshold = threshold;
+        d_config_changed = true;
+    }
 
-        if (success) d_num_frames_decoded++;
+    void ccsds_decoder_impl::set_rs_decode(bool rs_decode)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.rs_decode = rs_decode;
+        d_config_changed = true;
+    }
 
-        return success;
+    void ccsds_decoder_impl::set_deinterleave(bool deinterleave)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.deinterleave = deinterleave;
+        d_config_changed = true;
+    }
+
+    void ccsds_decoder_impl::set_descramble(bool descramble)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.descramble = descramble;
+        d_config_changed = true;
+    }
+
+    void ccsds_decoder_impl::set_n_interleave(int n_interleave)
+    {
+        if (n_interleave < 1 || n_interleave > RS_MAX_NBLOCKS) {
+            throw std::runtime_error("n_interleave must be between 1 and 8");
+        }
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.n_interleave = n_interleave;
+        d_config_changed = true;
+    }
+
+    void ccsds_decoder_impl::set_dual_basis(bool dual_basis)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.dual_basis = dual_basis;
+        d_config_changed = true;
+    }
+
+    void ccsds_decoder_impl::apply_config()
+    {
+        // called between frames only, so a frame never mixes settings
+        if (!d_config_changed) return;
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_cfg = d_pending_cfg;
+        d_config_changed = false;
+        if (d_verbose) printf("applied new configuration\n");
+    }
+
+    void ccsds_decoder_impl::handle_config(pmt::pmt_t msg)
+    {
+        if (pmt::is_pair(msg)) msg = pmt::car(msg);
+        if (!pmt::is_dict(msg)) {
+            printf("[ERROR] expected a dictionary of settings\n");
+            return;
+        }
+
+        const pmt::pmt_t not_found = pmt::PMT_NIL;
+        pmt::pmt_t v;
+        if (pmt::is_integer(v = pmt::dict_ref(msg, pmt::intern("threshold"), not_found))) {
+            const long t = pmt::to_long(v);
+            if (t < 0 || t >= d_asm_len) {
+                printf("[ERROR] threshold must be between 0 and %i, got %li\n", d_asm_len - 1, t);
+            } else {
+                set_threshold(t);
+            }
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("rs_decode"), not_found))) {
+            set_rs_decode(pmt::to_bool(v));
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("deinterleave"), not_found))) {
+            set_deinterleave(pmt::to_bool(v));
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("descramble"), not_found))) {
+            set_descramble(pmt::to_bool(v));
+        }
+        if (pmt::is_integer(v = pmt::dict_ref(msg, pmt::intern("n_interleave"), not_found))) {
+            const long n = pmt::to_long(v);
+            if (n < 1 || n > RS_MAX_NBLOCKS) {
+                printf("[ERROR] n_interleave must be between 1 and 8, got %li\n", n);
+            } else {
+                set_n_interleave(n);
+            }
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("dual_basis"), not_found))) {
+            set_dual_basis(pmt::to_bool(v));
+        }
     }
+
   } /* namespace ccsds */
 } /* namespace gr */
@@ -22,8 +22,16 @@
 #define INCLUDED_CCSDS_CCSDS_DECODER_IMPL_H
 
 #include <gnuradio/ccsds/ccsds_decoder.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "ccsds.h"
 #include "reed_solomon.h"
+#include "spsc_ring.h"
 
 namespace gr {
   namespace ccsds {
@@ -31,43 +39,120 @@ namespace gr {
     class ccsds_decoder_impl : public ccsds_decoder
     {
      private:
-         uint8_t d_threshold;
-         bool d_rs_decode;
-         bool d_deinterleave;
-         bool d_descramble;
+         // settings that may change between frames
+         struct frame_config {
+             uint8_t threshold;
+             bool rs_decode;
+             bool deinterleave;
+             bool descramble;
+             int  n_interleave;
+             bool dual_basis;
+         };
+
+         struct codeword_slot {
+             frame_config cfg;
+             uint8_t data[CODEWORD_MAX_LEN];
+         };
+
+         frame_config d_cfg;
          bool d_verbose;
          bool d_printing;
-         int  d_n_interleave;
-         bool d_dual_basis;
+         int  d_slip_window;
+         int  d_queue_depth;
+         bool d_drop_on_overflow;
+         const bool d_nrzm;
+         uint8_t d_nrzm_last;  // last raw input bit
 
-         uint32_t d_sync_word;
+         const uint64_t d_asm;
+         const uint64_t d_asm_mask;
+         const int d_asm_len;    // bits covered by the mask
          uint8_t d_decoder_state;
          uint32_t d_data_reg;
-         uint8_t d_bit_counter;
-         uint16_t d_byte_counter;
+         uint64_t d_search_reg;
+         int d_bit_counter;
+         int d_byte_counter;
          uint32_t d_num_frames_received;
-         uint32_t d_num_frames_decoded;
-         uint32_t d_num_subframes_decoded;
+         std::atomic<uint32_t> d_num_frames_decoded;
+         std::atomic<uint32_t> d_num_subframes_decoded;
+         uint32_t d_num_bit_slips;
+         std::atomic<uint32_t> d_num_false_locks;
+         const bool d_check_fecf;
+         const bool d_drop_fecf_errors;
+         std::atomic<uint32_t> d_num_fecf_errors;
+         bit_history d_history;
+         int d_resync_bits;
+
+         // recent input bits, so that the decoder can go back to an
+         // earlier sync word candidate when a locked frame fails to decode
+         std::vector<uint8_t> d_ring;
+         uint64_t d_ring_mask;
+         uint64_t d_written;    // bits written to the ring
+         uint64_t d_pos;        // next bit read by the decoder
+         uint64_t d_lock_pos;   // first codeword bit of the locked frame
+         std::deque<uint64_t> d_candidates; // first bits after sync words
+
          uint8_t d_codeword[CODEWORD_MAX_LEN];
          uint8_t d_payload[DATA_MAX_LEN];
          reed_solomon d_rs;
 
-         int data_len() { return RS_DATA_LEN * d_n_interleave; }
-         int codeword_len() { return RS_BLOCK_LEN * d_n_interleave; }
+         // codewords waiting for the decode thread when queue_depth > 0
+         std::unique_ptr<spsc_ring<codeword_slot>> d_queue;
+         std::thread d_decode_thread;
+         std::mutex d_queue_mutex;
+         std::condition_variable d_data_cond;
+         std::condition_variable d_space_cond;
+         std::atomic<bool> d_running;
+         std::atomic<uint32_t> d_num_frames_dropped;
+         std::atomic<uint32_t> d_max_queue_depth;
+
+         // settings from the setters, applied at the next frame boundary
+         std::mutex d_config_mutex;
+         frame_config d_pending_cfg;
+         std::atomic<bool> d_config_changed;
+
+         int data_len() { return d_rs.data_len() * d_cfg.n_interleave; }
+         int codeword_len() { return d_rs.block_len() * d_cfg.n_interleave; }
          int total_frame_len() { return SYNC_WORD_LEN + codeword_len(); }
 
          void enter_sync_search();
          void enter_codeword();
-         bool compare_sync_word();
-         bool decode_frame();
+         void enter_resync();
+         void lock(uint64_t pos);
+         void drop_candidates(uint64_t pos);
+         bool add_codeword_bit(uint8_t bit);
+         void end_codeword();
+         void resync();
+         bool compare_sync_word(uint64_t reg);
+         bool decode_frame(const uint8_t *codeword, uint8_t *payload, const frame_config &cfg);
+         void publish_frame(const uint8_t *payload, int len);
+         void queue_codeword();
+         void decode_loop();
+         void apply_config();
+         void handle_config(pmt::pmt_t msg);
 
      public:
-      ccsds_decoder_impl(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis);
+      ccsds_decoder_impl(int threshold, bool rs_decode, bool deinterleave, bool descramble, bool verbose, bool printing, int n_interleave, bool dual_basis, int slip_window, int queue_depth, bool drop_on_overflow, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors);
       ~ccsds_decoder_impl();
 
       uint32_t num_frames_received() const {return d_num_frames_received;}
       uint32_t num_frames_decoded() const {return d_num_frames_decoded;}
       uint32_t num_subframes_decoded() const {return d_num_subframes_decoded;}
+      uint32_t num_bit_slips() const {return d_num_bit_slips;}
+      uint32_t num_false_locks() const {return d_num_false_locks;}
+      uint32_t num_frames_dropped() const {return d_num_frames_dropped;}
+      uint32_t num_fecf_errors() const {return d_num_fecf_errors;}
+      uint32_t queue_depth() const {return d_queue ? d_queue->size() : 0;}
+      uint32_t max_queue_depth() const {return d_max_queue_depth;}
+
+      void set_threshold(int threshold);
+      void set_rs_decode(bool rs_decode);
+      void set_deinterleave(bool deinterleave);
+      void set_descramble(bool descramble);
+      void set_n_interleave(int n_interleave);
+      void set_dual_basis(bool dual_basis);
+
+      bool start();
+      bool stop();
 
       // Where all the action really happens
       int work(int noutput_items,
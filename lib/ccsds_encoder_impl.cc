@@ -23,9 +23,15 @@
 #endif
 
 #include <stdio.h>
+#include <algorithm>
+#include <thread>
 #include <gnuradio/io_signature.h>
 #include "ccsds_encoder_impl.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "ccsds.h"
 #include "reed_solomon.h"
 
@@ -33,35 +39,101 @@ namespace gr {
   namespace ccsds {
 
     ccsds_encoder::sptr
-    ccsds_encoder::make(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis)
+    ccsds_encoder::make(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis, bool continuous, double frame_rate, bool segment, int scid, int vcid, double flush_timeout, output_format_t output_format, bool nrzm, int rs_e, int virtual_fill, bool fecf)
     {
       return gnuradio::get_initial_sptr
-        (new ccsds_encoder_impl(itemsize, len_tag_key, rs_encode, interleave, scramble, printing, verbose, n_interleave, dual_basis));
+        (new ccsds_encoder_impl(itemsize, len_tag_key, rs_encode, interleave, scramble, printing, verbose, n_interleave, dual_basis, continuous, frame_rate, segment, scid, vcid, flush_timeout, output_format, nrzm, rs_e, virtual_fill, fecf));
     }
 
     /*
      * The private constructor
      */
-    ccsds_encoder_impl::ccsds_encoder_impl(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis)
+    ccsds_encoder_impl::ccsds_encoder_impl(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis, bool continuous, double frame_rate, bool segment, int scid, int vcid, double flush_timeout, output_format_t output_format, bool nrzm, int rs_e, int virtual_fill, bool fecf)
       : gr::tagged_stream_block("ccsds_encoder",
               gr::io_signature::make(itemsize==0 ? 0:1, itemsize==0 ? 0:1, itemsize),
-              gr::io_signature::make(1, 1, sizeof(uint8_t)), len_tag_key),
+              gr::io_signature::make(1, 1, output_format == OUTPUT_SOFT ? sizeof(float) : sizeof(uint8_t)), (continuous || segment) ? "" : len_tag_key),
         d_itemsize(itemsize),
-        d_rs_encode(rs_encode),
-        d_interleave(interleave),
-        d_scramble(scramble),
+        d_batch(len_tag_key.empty() || continuous || segment),
+        d_continuous(continuous),
+        d_frame_rate(frame_rate),
+        d_segment(segment),
+        d_scid(scid),
+        d_vcid(vcid),
+        d_flush_timeout(flush_timeout),
+        d_format(output_format),
+        d_items_per_byte(output_format == OUTPUT_PACKED ? 1 : 8),
+        d_nrzm(nrzm),
+        d_nrzm_level(0),
         d_printing(printing),
         d_verbose(verbose),
-        d_n_interleave(n_interleave),
-        d_dual_basis(dual_basis),
+        d_config_changed(false),
         d_curr_len(0),
-        d_num_frames(0)
+        d_num_frames(0),
+        d_num_idle_frames(0),
+        d_num_paced(0),
+        d_seg_offset(0),
+        d_seg_bytes(0),
+        d_seg_npdus(0),
+        d_flush_running(false),
+        d_flush_armed(false),
+        d_mc_count(0),
+        d_vc_count(0),
+        d_rs(rs_e, virtual_fill),
+        d_fecf(fecf)
     {
+      if (n_interleave < 1 || n_interleave > RS_MAX_NBLOCKS) {
+          throw std::runtime_error("n_interleave must be between 1 and 8");
+      }
+      if (continuous && itemsize != 0) {
+          throw std::runtime_error("continuous mode takes pdus, itemsize must be 0");
+      }
+      if (frame_rate < 0) {
+          throw std::runtime_error("frame_rate must not be negative");
+      }
+      if (segment && itemsize != 0) {
+          throw std::runtime_error("segmentation takes pdus, itemsize must be 0");
+      }
+      // n_interleave may be set as low as 1 later
+      if (segment && d_rs.data_len() - (fecf ? FECF_LEN : 0) <= TM_PRIMARY_HEADER_LEN) {
+          throw std::runtime_error("the frame is too short for a transfer frame header");
+      }
+      if (scid < 0 || scid > 1023 || vcid < 0 || vcid > 7) {
+          throw std::runtime_error("scid must be between 0 and 1023 and vcid between 0 and 7");
+      }
+      if (flush_timeout < 0) {
+          throw std::runtime_error("flush_timeout must not be negative");
+      }
+      if (output_format < OUTPUT_PACKED || output_format > OUTPUT_SOFT) {
+          throw std::runtime_error("unknown output format");
+      }
+      d_cfg.rs_encode = rs_encode;
+      d_cfg.interleave = interleave;
+      d_cfg.scramble = scramble;
+      d_cfg.n_interleave = n_interleave;
+      d_cfg.dual_basis = dual_basis;
+      d_pending_cfg = d_cfg;
+      if (d_continuous) d_idle_frames.resize(256);
+
       if (d_itemsize == 0) {
           message_port_register_in(pmt::mp("in"));
       }
+      message_port_register_in(pmt::mp("config"));
+      if (d_segment && !d_continuous) {
+          // nothing to handle, the message only makes the scheduler call work()
+          message_port_register_in(pmt::mp("flush"));
+          set_msg_handler(pmt::mp("flush"), [](pmt::pmt_t) {});
+      }
+
+      // room for several frames at the deepest interleaving
+      set_min_output_buffer(OUTPUT_BUFFER_FRAMES * (SYNC_WORD_LEN + CODEWORD_MAX_LEN) * d_items_per_byte);
+      if (d_batch) {
+          // without a length tag work() is called directly, and always
+          // gets room for at least one frame
+          set_min_noutput_items((SYNC_WORD_LEN + CODEWORD_MAX_LEN) * d_items_per_byte);
+      }
+      d_frame.resize(SYNC_WORD_LEN + CODEWORD_MAX_LEN);
+      set_msg_handler(pmt::mp("config"), [this](pmt::pmt_t msg) { this->handle_config(msg); });
 
-      memcpy(d_pkt.sync_word, SYNC_WORD, SYNC_WORD_LEN);
     }
 
     /*
@@ -69,7 +141,7 @@ namespace gr {
      */
     ccsds_encoder_impl::~ccsds_encoder_impl()
     {
-
+        stop();
     }
 
     int
@@ -80,6 +152,9 @@ namespace gr {
 
             if (d_curr_len != 0) return 0;
 
+            // nothing is pending, so this is a frame boundary
+            apply_config();
+
             pmt::pmt_t msg(delete_head_nowait(pmt::mp("in")));
             if (msg.get() == NULL) {
                 return 0;
@@ -90,8 +165,10 @@ namespace gr {
             d_curr_meta = pmt::car(msg);
             d_curr_vec = pmt::cdr(msg);
             d_curr_len = pmt::length(d_curr_vec);
+        } else {
+            apply_config();
         }
-        return total_frame_len();
+        return output_frame_len();
     }
 
     int
@@ -100,14 +177,20 @@ namespace gr {
                        gr_vector_const_void_star &input_items,
                        gr_vector_void_star &output_items)
     {
+      if (d_continuous) {
+          return work_continuous(noutput_items, output_items);
+      }
+      if (d_batch) {
+          return work_batch(noutput_items, ninput_items, input_items, output_items);
+      }
 
       const uint8_t* in;
       if (d_itemsize == 0) {
           // see if there is anything to do
           if (d_curr_len == 0) return 0;
 
-          if (d_curr_len != data_len()) {
-              printf("[ERROR] expected %i bytes, got %i\n", data_len(), (int)d_curr_len);
+          if (d_curr_len != input_len()) {
+              printf("[ERROR] expected %i bytes, got %i\n", input_len(), (int)d_curr_len);
               d_curr_len = 0;
               return 0;
           }
@@ -117,40 +200,284 @@ namespace gr {
       } else {
           in = (const uint8_t*) input_items[0];
       }
-      uint8_t *out = (uint8_t *) output_items[0];
       //copy_stream_tags();
 
-      uint8_t rs_block[RS_BLOCK_LEN];
-      for (uint8_t i=0; i<d_n_interleave; i++) {
+      uint8_t *frame = frame_buffer(output_items[0], 0);
+      encode_frame(in, frame);
+      frame_sent(frame);
+
+      // reset state
+      d_curr_len = 0;
+      return output_frame(frame, output_items[0], 0);
+    }
+
+    void
+    ccsds_encoder_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+    {
+        if (!d_batch) {
+            tagged_stream_block::forecast(noutput_items, ninput_items_required);
+            return;
+        }
+        // one frame of data per frame of output
+        const int nframes = std::max(1, noutput_items / output_frame_len());
+        for (size_t i=0; i<ninput_items_required.size(); i++) {
+            ninput_items_required[i] = nframes * input_len();
+        }
+    }
+
+    int
+    ccsds_encoder_impl::work_batch(int noutput_items,
+                                   gr_vector_int &ninput_items,
+                                   gr_vector_const_void_star &input_items,
+                                   gr_vector_void_star &output_items)
+    {
+        int produced = 0;
+        int consumed = 0;
+
+        // encode as many frames as there is data and room for
+        while (true) {
+            apply_config();
+            if (noutput_items - produced < output_frame_len()) break;
+
+            uint8_t *frame = frame_buffer(output_items[0], produced);
+            const uint8_t *in;
+            if (d_segment) {
+                const bool expired = d_seg_npdus > 0 &&
+                    std::chrono::steady_clock::now() >= d_seg_deadline;
+                // a partial frame is sent on a later call, from the next
+                // pdu or from the flush thread
+                if (!segment_frame(frame, expired)) break;
+            } else if (d_itemsize == 0) {
+                pmt::pmt_t msg(delete_head_nowait(pmt::mp("in")));
+                if (msg.get() == NULL) break;
+                if (!pmt::is_pair(msg)) {
+                    throw std::runtime_error("received a malformed pdu message");
+                }
+                const pmt::pmt_t vec = pmt::cdr(msg);
+                size_t len = 0;
+                in = (const uint8_t*) uniform_vector_elements(vec, len);
+                if (len != (size_t)input_len()) {
+                    printf("[ERROR] expected %i bytes, got %i\n", input_len(), (int)len);
+                    continue;
+                }
+                encode_frame(in, frame);
+            } else {
+                if (ninput_items[0] - consumed < input_len()) break;
+                in = (const uint8_t*) input_items[0];
+                encode_frame(&in[consumed], frame);
+                consumed += input_len();
+            }
+            frame_sent(frame);
+            produced += output_frame(frame, output_items[0], produced);
+        }
+
+        if (d_itemsize != 0) consume_each(consumed);
+        return produced;
+    }
+
+    void
+    ccsds_encoder_impl::arm_flush()
+    {
+        std::lock_guard<std::mutex> lock(d_flush_mutex);
+        d_flush_armed = true;
+        d_flush_cond.notify_one();
+    }
+
+    void
+    ccsds_encoder_impl::flush_loop()
+    {
+        // a wake up after the frame went out anyway only costs an empty
+        // call to work()
+        std::unique_lock<std::mutex> lock(d_flush_mutex);
+        while (d_flush_running) {
+            if (!d_flush_armed) {
+                d_flush_cond.wait(lock);
+                continue;
+            }
+            const std::chrono::steady_clock::time_point deadline = d_seg_deadline;
+            if (d_flush_cond.wait_until(lock, deadline) == std::cv_status::timeout) {
+                d_flush_armed = false;
+                lock.unlock();
+                _post(pmt::mp("flush"), pmt::PMT_T);
+                lock.lock();
+            }
+        }
+    }
+
+    bool
+    ccsds_encoder_impl::start()
+    {
+        if (d_segment && !d_continuous && !d_flush_running) {
+            d_flush_running = true;
+            d_flush_thread = std::thread(&ccsds_encoder_impl::flush_loop, this);
+        }
+        return tagged_stream_block::start();
+    }
+
+    bool
+    ccsds_encoder_impl::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(d_flush_mutex);
+            d_flush_running = false;
+        }
+        d_flush_cond.notify_all();
+        if (d_flush_thread.joinable()) d_flush_thread.join();
+        return tagged_stream_block::stop();
+    }
+
+    // store len bytes at codeword[k], codeword[k+step], ... xored with the
+    // pseudo randomizer from position s, and advance k and s past them
+    static inline void store_scrambled(uint8_t *codeword, const uint8_t *src, int len,
+                                       int &k, int &s, int step, uint8_t mask)
+    {
+        for (int j=0; j<len; j++) {
+            codeword[k] = src[j] ^ (SCRAMBLER_POLY[s] & mask);
+            k += step;
+            s += step;
+            if (s >= SCRAMBLER_POLY_LEN) s -= SCRAMBLER_POLY_LEN;
+        }
+    }
+
+    void
+    ccsds_encoder_impl::encode_frame(const uint8_t *in, uint8_t *out)
+    {
+      if (d_fecf) {
+          d_fecf_frame.resize(data_len());
+          memcpy(d_fecf_frame.data(), in, input_len());
+          append_fecf(d_fecf_frame.data(), input_len());
+          in = d_fecf_frame.data();
+      }
+
+      // the frame is written straight to out, and each byte of the
+      // codeword is scrambled as it is stored
+      memcpy(out, SYNC_WORD, SYNC_WORD_LEN);
+      uint8_t *codeword = &out[SYNC_WORD_LEN];
+      const int n = d_cfg.n_interleave;
+      const uint8_t scramble_mask = d_cfg.scramble ? 0xff : 0x00;
 
-          // copy data from input to rs block
-          if (d_interleave) {
-              for (uint8_t j=0; j<RS_BLOCK_LEN; j++)
-                  rs_block[j] = in[i + (d_n_interleave*j)];
+      const int data_len = d_rs.data_len();
+      const int parity_len = d_rs.parity_len();
+      uint8_t rs_block[RS_NN];
+      uint8_t parity[RS_PARITY_LEN];
+      for (int i=0; i<n; i++) {
+
+          // the rs encoder needs the data of a block in one piece
+          const uint8_t *data;
+          if (d_cfg.interleave) {
+              for (int j=0; j<data_len; j++)
+                  rs_block[j] = in[i + n*j];
+              data = rs_block;
           } else {
-              memcpy(rs_block, &in[i*RS_DATA_LEN], RS_DATA_LEN);
+              data = &in[i*data_len];
           }
 
           // calculate parity data
-          if (d_rs_encode) {
-              d_rs.encode(rs_block, d_dual_basis);
+          if (d_cfg.rs_encode) {
+              d_rs.encode(data, parity, d_cfg.dual_basis);
           } else {
-              memset(&rs_block[RS_DATA_LEN], 0, RS_PARITY_LEN);
+              memset(parity, 0, parity_len);
           }
 
-          // data into output array
-          if (d_interleave) {
-              for (uint8_t j=0; j<RS_BLOCK_LEN; j++)
-                  d_pkt.codeword[i + (d_n_interleave*j)] = rs_block[j];
-          } else {
-              memcpy(&d_pkt.codeword[i*RS_BLOCK_LEN], rs_block, RS_BLOCK_LEN);
+          // data and parity into the output, interleaved codeword byte k
+          // at i + n*j, or at i*block_len + j without interleaving
+          const int step = d_cfg.interleave ? n : 1;
+          int k = d_cfg.interleave ? i : i*d_rs.block_len();
+          int s = k % SCRAMBLER_POLY_LEN;
+          store_scrambled(codeword, data, data_len, k, s, step, scramble_mask);
+          store_scrambled(codeword, parity, parity_len, k, s, step, scramble_mask);
+      }
+
+    }
+
+    // expand n packed bytes to one bit per byte, most significant bit first
+    static void unpack_bits(const uint8_t *in, int n, uint8_t *out)
+    {
+      int i = 0;
+#if defined(__AVX2__)
+      // each byte of four goes to eight lanes, which keep one bit each
+      const __m256i spread = _mm256_setr_epi8(0,0,0,0,0,0,0,0, 1,1,1,1,1,1,1,1,
+                                              2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3);
+      const __m256i bits = _mm256_set1_epi64x(0x0102040810204080);
+      const __m256i ones = _mm256_set1_epi8(1);
+      for (; i+4<=n; i+=4) {
+          uint32_t w;
+          memcpy(&w, &in[i], 4);
+          __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(w), spread);
+          v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bits), bits);
+          _mm256_storeu_si256((__m256i *)&out[8*i], _mm256_and_si256(v, ones));
+      }
+#endif
+      for (; i<n; i++) {
+          for (int j=0; j<8; j++) out[8*i+j] = (in[i] >> (7-j)) & 0x01;
+      }
+    }
+
+    // expand n packed bytes to +1.0 for a one and -1.0 for a zero
+    static void unpack_soft(const uint8_t *in, int n, float *out)
+    {
+      int i = 0;
+#if defined(__AVX2__)
+      const __m256i bits = _mm256_setr_epi32(0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+      const __m256 one = _mm256_set1_ps(1.0f);
+      const __m256 minus_one = _mm256_set1_ps(-1.0f);
+      for (; i<n; i++) {
+          const __m256i v = _mm256_and_si256(_mm256_set1_epi32(in[i]), bits);
+          const __m256 set = _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, bits));
+          _mm256_storeu_ps(&out[8*i], _mm256_blendv_ps(minus_one, one, set));
+      }
+#endif
+      for (; i<n; i++) {
+          for (int j=0; j<8; j++) out[8*i+j] = ((in[i] >> (7-j)) & 0x01) ? 1.0f : -1.0f;
+      }
+    }
+
+    uint8_t *
+    ccsds_encoder_impl::frame_buffer(void *out, int produced)
+    {
+      // packed frames are encoded straight into the output
+      if (d_format == OUTPUT_PACKED) return &((uint8_t *) out)[produced];
+      return d_frame.data();
+    }
+
+    int
+    ccsds_encoder_impl::output_frame(const uint8_t *frame, void *out, int produced)
+    {
+      const int len = total_frame_len();
+      uint8_t *packed = frame_buffer(out, produced);
+      if (frame != packed) memcpy(packed, frame, len);
+
+      if (d_nrzm) {
+          // a one is sent as a change of level. the running xor of the bits
+          // of a byte, from the most significant one, is done in three
+          // shifts and then offset by the level before it.
+          for (int i=0; i<len; i++) {
+              uint8_t b = packed[i];
+              b ^= b >> 1;
+              b ^= b >> 2;
+              b ^= b >> 4;
+              if (d_nrzm_level) b = ~b;
+              packed[i] = b;
+              d_nrzm_level = b & 0x01;
           }
       }
 
-      if (d_scramble) {
-          scramble(d_pkt.codeword, codeword_len());
+      switch (d_format) {
+          case OUTPUT_UNPACKED:
+              unpack_bits(packed, len, &((uint8_t *) out)[produced]);
+              break;
+          case OUTPUT_SOFT:
+              unpack_soft(packed, len, &((float *) out)[produced]);
+              break;
+          default:
+              break;
       }
+      return len * d_items_per_byte;
+    }
 
+    void
+    ccsds_encoder_impl::frame_sent(const uint8_t *frame)
+    {
       d_num_frames++;
       if (d_verbose) {
           printf("sending %i bytes of data\n", total_frame_len());
@@ -158,15 +485,170 @@ namespace gr {
       }
 
       if (d_printing) {
-          print_bytes(d_pkt.codeword, codeword_len());
+          print_bytes((uint8_t *)&frame[SYNC_WORD_LEN], codeword_len());
       }
+    }
 
-      // copy data into output array
-      memcpy(out, &d_pkt, total_frame_len());
+    const uint8_t *
+    ccsds_encoder_impl::idle_frame()
+    {
+      // a transfer frame of only idle data on the idle virtual channel.
+      // with segmentation the encoder owns the master channel, so the
+      // idle frame takes the next master channel frame count. otherwise
+      // the count is left at zero. the virtual channel count is always
+      // zero, so there are at most 256 different idle frames to encode.
+      const uint8_t mc_count = d_segment ? d_mc_count++ : 0;
+      std::vector<uint8_t> &frame = d_idle_frames[mc_count];
+      if (frame.empty()) {
+          std::vector<uint8_t> data(input_len(), TM_IDLE_PATTERN);
+          tm_primary_header(data.data(), d_scid, TM_IDLE_VCID, mc_count, 0, TM_FHP_IDLE);
+          frame.resize(total_frame_len());
+          encode_frame(data.data(), frame.data());
+      }
+      return frame.data();
+    }
 
-      // reset state
-      d_curr_len = 0;
-      return total_frame_len();
+    int
+    ccsds_encoder_impl::frames_due(int max_frames)
+    {
+      if (d_frame_rate <= 0) return max_frames;
+
+      // send frames at frame_rate from the first call, waiting for the
+      // next one when none is due like a throttle does
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if (d_num_paced == 0) d_start_time = now;
+      const double elapsed = std::chrono::duration<double>(now - d_start_time).count();
+      int64_t due = (int64_t)(elapsed * d_frame_rate) + 1 - (int64_t)d_num_paced;
+      if (due <= 0) {
+          std::this_thread::sleep_until(d_start_time +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(d_num_paced / d_frame_rate)));
+          due = 1;
+      }
+      return (int)std::min<int64_t>(due, max_frames);
+    }
+
+    void
+    ccsds_encoder_impl::pull_segments(size_t need)
+    {
+      // take pdus off the queue until there is enough for a frame
+      while (d_seg_bytes < need) {
+          pmt::pmt_t msg(delete_head_nowait(pmt::mp("in")));
+          if (msg.get() == NULL) return;
+          if (!pmt::is_pair(msg)) {
+              throw std::runtime_error("received a malformed pdu message");
+          }
+          const pmt::pmt_t vec = pmt::cdr(msg);
+          size_t len = 0;
+          const uint8_t *in = (const uint8_t*) uniform_vector_elements(vec, len);
+          if (len < SPACE_PACKET_MIN_LEN || space_packet_len(in) != len) {
+              printf("[ERROR] pdu of %i bytes is not a space packet\n", (int)len);
+              continue;
+          }
+          if (d_seg_npdus == 0) {
+              {
+                  std::lock_guard<std::mutex> lock(d_flush_mutex);
+                  d_seg_deadline = std::chrono::steady_clock::now() +
+                      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(d_flush_timeout));
+              }
+              if (!d_continuous) arm_flush();
+          }
+          d_seg_queue.push_back({vec, false});
+          d_seg_bytes += len;
+          d_seg_npdus++;
+      }
+    }
+
+    bool
+    ccsds_encoder_impl::segment_frame(uint8_t *out, bool flush)
+    {
+      const size_t field_len = input_len() - TM_PRIMARY_HEADER_LEN;
+      pull_segments(field_len);
+      if (d_seg_bytes < field_len) {
+          if (!flush || d_seg_npdus == 0) return false;
+
+          // fill the rest of the frame with an idle packet. one shorter
+          // than the smallest packet runs on into the next frame.
+          const size_t idle_len = std::max(field_len - d_seg_bytes, (size_t)SPACE_PACKET_MIN_LEN);
+          pmt::pmt_t idle = pmt::make_u8vector(idle_len, TM_IDLE_PATTERN);
+          size_t len = 0;
+          space_packet_header(pmt::u8vector_writable_elements(idle, len),
+                              SPACE_PACKET_IDLE_APID, 0, idle_len);
+          d_seg_queue.push_back({idle, true});
+          d_seg_bytes += idle_len;
+      }
+
+      d_seg_frame.resize(input_len());
+      uint8_t *field = &d_seg_frame[TM_PRIMARY_HEADER_LEN];
+      uint16_t fhp = TM_FHP_NO_PACKET;
+      size_t pos = 0;
+      while (pos < field_len) {
+          const segment &seg = d_seg_queue.front();
+          size_t len = 0;
+          const uint8_t *in = (const uint8_t*) uniform_vector_elements(seg.vec, len);
+          if (d_seg_offset == 0 && fhp == TM_FHP_NO_PACKET) fhp = pos;
+
+          const size_t n = std::min(len - d_seg_offset, field_len - pos);
+          memcpy(&field[pos], &in[d_seg_offset], n);
+          pos += n;
+          d_seg_offset += n;
+          d_seg_bytes -= n;
+          if (d_seg_offset == len) {
+              if (!seg.idle) d_seg_npdus--;
+              d_seg_queue.pop_front();
+              d_seg_offset = 0;
+          }
+      }
+
+      tm_primary_header(d_seg_frame.data(), d_scid, d_vcid, d_mc_count++, d_vc_count++, fhp);
+      encode_frame(d_seg_frame.data(), out);
+      return true;
+    }
+
+    int
+    ccsds_encoder_impl::work_continuous(int noutput_items, gr_vector_void_star &output_items)
+    {
+      int produced = 0;
+
+      const int nframes = frames_due(noutput_items / ((SYNC_WORD_LEN + CODEWORD_MAX_LEN) * d_items_per_byte));
+      for (int i=0; i<nframes; i++) {
+          apply_config();
+          uint8_t *frame = frame_buffer(output_items[0], produced);
+
+          // queued pdus go first, an idle frame fills in for a missing one
+          bool sent = false;
+          pmt::pmt_t msg;
+          if (d_segment) {
+              // partial frames go out rather than an idle frame
+              sent = segment_frame(frame, true);
+          } else {
+              msg = delete_head_nowait(pmt::mp("in"));
+          }
+          while (!sent && msg.get() != NULL) {
+              if (!pmt::is_pair(msg)) {
+                  throw std::runtime_error("received a malformed pdu message");
+              }
+              size_t len = 0;
+              const uint8_t *in = (const uint8_t*) uniform_vector_elements(pmt::cdr(msg), len);
+              if (len == (size_t)input_len()) {
+                  encode_frame(in, frame);
+                  sent = true;
+              } else {
+                  printf("[ERROR] expected %i bytes, got %i\n", input_len(), (int)len);
+                  msg = delete_head_nowait(pmt::mp("in"));
+              }
+          }
+          const uint8_t *sent_frame = frame;
+          if (!sent) {
+              sent_frame = idle_frame();
+              d_num_idle_frames++;
+          }
+          frame_sent(sent_frame);
+          produced += output_frame(sent_frame, output_items[0], produced);
+          d_num_paced++;
+      }
+      return produced;
     }
 
     void
@@ -182,6 +664,93 @@ namespace gr {
         }
     }
 
+    void
+    ccsds_encoder_impl::set_rs_encode(bool rs_encode)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.rs_encode = rs_encode;
+        d_config_changed = true;
+    }
+
+    void
+    ccsds_encoder_impl::set_interleave(bool interleave)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.interleave = interleave;
+        d_config_changed = true;
+    }
+
+    void
+    ccsds_encoder_impl::set_scramble(bool scramble)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.scramble = scramble;
+        d_config_changed = true;
+    }
+
+    void
+    ccsds_encoder_impl::set_n_interleave(int n_interleave)
+    {
+        if (n_interleave < 1 || n_interleave > RS_MAX_NBLOCKS) {
+            throw std::runtime_error("n_interleave must be between 1 and 8");
+        }
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.n_interleave = n_interleave;
+        d_config_changed = true;
+    }
+
+    void
+    ccsds_encoder_impl::set_dual_basis(bool dual_basis)
+    {
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_pending_cfg.dual_basis = dual_basis;
+        d_config_changed = true;
+    }
+
+    void
+    ccsds_encoder_impl::apply_config()
+    {
+        if (!d_config_changed) return;
+        std::lock_guard<std::mutex> lock(d_config_mutex);
+        d_cfg = d_pending_cfg;
+        d_config_changed = false;
+        if (d_continuous) d_idle_frames.assign(256, std::vector<uint8_t>());
+        if (d_verbose) printf("applied new configuration\n");
+    }
+
+    void
+    ccsds_encoder_impl::handle_config(pmt::pmt_t msg)
+    {
+        if (pmt::is_pair(msg)) msg = pmt::car(msg);
+        if (!pmt::is_dict(msg)) {
+            printf("[ERROR] expected a dictionary of settings\n");
+            return;
+        }
+
+        const pmt::pmt_t not_found = pmt::PMT_NIL;
+        pmt::pmt_t v;
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("rs_encode"), not_found))) {
+            set_rs_encode(pmt::to_bool(v));
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("interleave"), not_found))) {
+            set_interleave(pmt::to_bool(v));
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("scramble"), not_found))) {
+            set_scramble(pmt::to_bool(v));
+        }
+        if (pmt::is_integer(v = pmt::dict_ref(msg, pmt::intern("n_interleave"), not_found))) {
+            const long n = pmt::to_long(v);
+            if (n < 1 || n > RS_MAX_NBLOCKS) {
+                printf("[ERROR] n_interleave must be between 1 and 8, got %li\n", n);
+            } else {
+                set_n_interleave(n);
+            }
+        }
+        if (pmt::is_bool(v = pmt::dict_ref(msg, pmt::intern("dual_basis"), not_found))) {
+            set_dual_basis(pmt::to_bool(v));
+        }
+    }
+
   } /* namespace ccsds */
 } /* namespace gr */
 
@@ -22,6 +22,13 @@
 #define INCLUDED_CCSDS_CCSDS_ENCODER_IMPL_H
 
 #include <gnuradio/ccsds/ccsds_encoder.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "ccsds.h"
 #include "reed_solomon.h"
 
@@ -31,29 +38,104 @@ namespace gr {
     class ccsds_encoder_impl : public ccsds_encoder
     {
      private:
+         // settings that may change between frames
+         struct frame_config {
+             bool rs_encode;
+             bool interleave;
+             bool scramble;
+             int  n_interleave;
+             bool dual_basis;
+         };
+
          size_t d_itemsize;
-         bool d_rs_encode;
-         bool d_interleave;
-         bool d_scramble;
+         bool d_batch;
+         const bool d_continuous;
+         const double d_frame_rate;
+         const bool d_segment;
+         const uint16_t d_scid;
+         const uint8_t d_vcid;
+         const double d_flush_timeout;
+         const output_format_t d_format;
+         const int d_items_per_byte;
+         const bool d_nrzm;
+         uint8_t d_nrzm_level;  // last bit sent when differentially coding
+         std::vector<uint8_t> d_frame;  // packed frame when not written in place
+         frame_config d_cfg;
          bool d_printing;
          bool d_verbose;
-         int  d_n_interleave;
-         bool d_dual_basis;
+
+         // settings from the setters, applied at the next frame boundary
+         std::mutex d_config_mutex;
+         frame_config d_pending_cfg;
+         std::atomic<bool> d_config_changed;
 
          uint32_t d_num_frames;
+         uint32_t d_num_idle_frames;
+
+         // encoded idle frames sent in continuous mode when no pdu is
+         // queued, one per master channel frame count. each is encoded on
+         // first use and dropped when the settings change.
+         std::vector<std::vector<uint8_t>> d_idle_frames;
+         std::chrono::steady_clock::time_point d_start_time;
+         uint64_t d_num_paced;
+
+         // space packets waiting to be segmented into transfer frames. the
+         // pdu vectors are kept and copied from as the frames are built.
+         struct segment {
+             pmt::pmt_t vec;
+             bool idle;
+         };
+         std::deque<segment> d_seg_queue;
+         size_t d_seg_offset;   // bytes of the front segment already framed
+         size_t d_seg_bytes;    // bytes queued, less the offset
+         int d_seg_npdus;       // queued segments that are not idle fill
+         std::chrono::steady_clock::time_point d_seg_deadline;
+
+         // work() returns without a frame while a partial one waits. this
+         // thread posts to the flush port when its deadline is reached, so
+         // that work() is called again to send it.
+         std::thread d_flush_thread;
+         std::mutex d_flush_mutex;
+         std::condition_variable d_flush_cond;
+         bool d_flush_running;
+         bool d_flush_armed;
+         std::vector<uint8_t> d_seg_frame;
+         uint8_t d_mc_count;
+         uint8_t d_vc_count;
 
          pmt::pmt_t d_curr_meta;
          pmt::pmt_t d_curr_vec;
          size_t d_curr_len;
 
-         struct ccsds_tx_pkt d_pkt;
          reed_solomon d_rs;
+         const bool d_fecf;
+         std::vector<uint8_t> d_fecf_frame; // frame data with the fecf appended
 
          void copy_stream_tags();
-
-         int data_len() { return RS_DATA_LEN * d_n_interleave; }
-         int codeword_len() { return RS_BLOCK_LEN * d_n_interleave; }
+         void encode_frame(const uint8_t *in, uint8_t *out);
+         void frame_sent(const uint8_t *frame);
+         uint8_t *frame_buffer(void *out, int produced);
+         int output_frame(const uint8_t *frame, void *out, int produced);
+         const uint8_t *idle_frame();
+         int frames_due(int max_frames);
+         void pull_segments(size_t need);
+         bool segment_frame(uint8_t *out, bool flush);
+         void arm_flush();
+         void flush_loop();
+         int work_continuous(int noutput_items, gr_vector_void_star &output_items);
+         int work_batch(int noutput_items,
+                        gr_vector_int &ninput_items,
+                        gr_vector_const_void_star &input_items,
+                        gr_vector_void_star &output_items);
+         void apply_config();
+         void handle_config(pmt::pmt_t msg);
+
+         int data_len() { return d_rs.data_len() * d_cfg.n_interleave; }
+         // frame data taken from the input, without the fecf
+         int input_len() { return data_len() - (d_fecf ? FECF_LEN : 0); }
+         int codeword_len() { return d_rs.block_len() * d_cfg.n_interleave; }
          int total_frame_len() { return SYNC_WORD_LEN + codeword_len(); }
+         int output_frame_len() { return total_frame_len() * d_items_per_byte; }
 
 
 
@@ -61,10 +143,22 @@ namespace gr {
       int calculate_output_stream_length(const gr_vector_int &ninput_items);
 
      public:
-      ccsds_encoder_impl(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis);
+      ccsds_encoder_impl(size_t itemsize, const std::string& len_tag_key, bool rs_encode, bool interleave, bool scramble, bool printing, bool verbose, int n_interleave, bool dual_basis, bool continuous, double frame_rate, bool segment, int scid, int vcid, double flush_timeout, output_format_t output_format, bool nrzm, int rs_e, int virtual_fill, bool fecf);
       ~ccsds_encoder_impl();
 
       uint32_t num_frames() const {return d_num_frames;}
+      uint32_t num_idle_frames() const {return d_num_idle_frames;}
+
+      bool start();
+      bool stop();
+
+      void set_rs_encode(bool rs_encode);
+      void set_interleave(bool interleave);
+      void set_scramble(bool scramble);
+      void set_n_interleave(int n_interleave);
+      void set_dual_basis(bool dual_basis);
+
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
 
       // Where all the action really happens
       int work(int noutput_items,
@@ -22,14 +22,17 @@
 #include "config.h"
 #endif
 
+#include <stdlib.h>
+#include <algorithm>
 #include <gnuradio/io_signature.h>
 #include <volk/volk.h>
 #include "correlator_impl.h"
+#include "ccsds.h"
 
-#if 1
+#if 0
 #define debug_print printf
 #else
-#define debug_print
+#define debug_print(...)
 #endif
 
 namespace gr {
@@ -37,23 +40,65 @@ namespace gr {
 
     correlator::sptr
     correlator::make(const uint64_t asm_, const uint64_t asm_mask,
-                     const uint8_t threshold, const size_t frame_len)
+                     const uint8_t threshold, const size_t frame_len,
+                     const int slip_window, const bool nrzm)
     {
       return gnuradio::get_initial_sptr
-        (new correlator_impl(asm_, asm_mask, threshold, frame_len));
+        (new correlator_impl(std::vector<uint64_t>(1, asm_),
+                             std::vector<uint64_t>(1, asm_mask),
+                             std::vector<uint8_t>(1, threshold),
+                             std::vector<size_t>(1, frame_len),
+                             slip_window, nrzm));
     }
 
-    correlator_impl::correlator_impl(const uint64_t asm_, const uint64_t asm_mask,
-                                     const uint8_t threshold, const size_t frame_len)
+    correlator::sptr
+    correlator::make(const std::vector<uint64_t> &asms,
+                     const std::vector<uint64_t> &asm_masks,
+                     const std::vector<uint8_t> &thresholds,
+                     const std::vector<size_t> &frame_lens,
+                     const int slip_window, const bool nrzm)
+    {
+      return gnuradio::get_initial_sptr
+        (new correlator_impl(asms, asm_masks, thresholds, frame_lens, slip_window, nrzm));
+    }
+
+    correlator_impl::correlator_impl(const std::vector<uint64_t> &asms,
+                                     const std::vector<uint64_t> &asm_masks,
+                                     const std::vector<uint8_t> &thresholds,
+                                     const std::vector<size_t> &frame_lens,
+                                     const int slip_window,
+                                     const bool nrzm)
       : gr::sync_block("correlator",
               gr::io_signature::make(1, 1, sizeof(uint8_t)),
               gr::io_signature::make(0, 0, 0)),
-      d_asm(asm_), d_asm_mask(asm_mask),
-      d_threshold(threshold), d_frame_len(frame_len),
+      d_marker(0), d_frame_len(0),
+      d_slip_window(slip_window), d_resync_bits(0), d_num_bit_slips(0),
+      d_nrzm(nrzm), d_nrzm_last(0),
       d_frame_count(0), d_ambiguity(NONE)
     {
+        if (asms.empty() || asm_masks.size() != asms.size() ||
+            thresholds.size() != asms.size() || frame_lens.size() != asms.size()) {
+            throw std::runtime_error("asms, asm_masks, thresholds and frame_lens must have the same non-zero length");
+        }
+        if (slip_window < 0 || slip_window > MAX_SLIP_WINDOW) {
+            throw std::runtime_error("slip_window must be between 0 and 32");
+        }
+        d_history.clear();
+
+        size_t max_frame_len = 0;
+        for (size_t i=0; i<asms.size(); i++) {
+            sync_marker marker;
+            marker.asm_ = asms[i];
+            marker.asm_mask = asm_masks[i];
+            marker.threshold = thresholds[i];
+            marker.frame_len = frame_lens[i];
+            marker.asm_len = asm_masks[i] ? 64 - __builtin_clzll(asm_masks[i]) : 0;
+            d_markers.push_back(marker);
+            max_frame_len = std::max(max_frame_len, frame_lens[i]);
+        }
+
         message_port_register_out(pmt::mp("out"));
-        d_frame_buffer = (uint8_t *)malloc(frame_len * sizeof(uint8_t));
+        d_frame_buffer = (uint8_t *)malloc(max_frame_len * sizeof(uint8_t));
         enter_state(SEARCH);
     }
 
@@ -68,35 +113,65 @@ namespace gr {
     {
         const uint8_t *in = (const uint8_t *) input_items[0];
 
-        uint64_t count = 0;
-        while (count < noutput_items) {
+        // size_t indices, so any buffer size the scheduler uses is fine
+        const size_t nitems = noutput_items;
+        size_t count = 0;
+        while (count < nitems) {
             switch (d_state) {
-            case SEARCH:
-                d_asm_buf = (d_asm_buf << 1) | (in[count++] & 0x01);
-                if (check_asm(d_asm_buf)) {
-                    d_ambiguity = NONE;
-                    enter_state(LOCK);
-                } else if (check_asm(d_asm_buf ^ 0xffffffffffffffff)) {
-                    d_ambiguity = INVERTED;
+            case SEARCH: {
+                const uint8_t bit = next_bit(in[count++]);
+                d_history.push(bit);
+                d_asm_buf = (d_asm_buf << 1) | bit;
+                if (find_asm()) {
                     enter_state(LOCK);
                 }
                 break;
-            case LOCK:
-                d_byte_buf = (d_byte_buf << 1) | (in[count++] & 0x01);
-                d_bit_ctr++;
-                if (d_bit_ctr == 8) {
-                    if (d_ambiguity == NONE) {
-                        d_frame_buffer[d_frame_buffer_len] = d_byte_buf;
-                    } else if (d_ambiguity == INVERTED) {
-                        d_frame_buffer[d_frame_buffer_len] = d_byte_buf ^ 0xff;
+            }
+            case LOCK: {
+                if (d_bit_ctr == 0) {
+                    // pack whole bytes of the frame in bulk
+                    const size_t nbytes = std::min(d_frame_len - d_frame_buffer_len,
+                                                   (nitems - count) / 8);
+                    if (nbytes > 0) {
+                        uint8_t *dst = &d_frame_buffer[d_frame_buffer_len];
+                        const size_t nbits = 8 * nbytes;
+                        if (d_nrzm) {
+                            // decode a word at a time once packed, keeping
+                            // the history in the decoded bits
+                            pack_bits(&in[count], dst, nbytes, false);
+                            d_nrzm_last = nrzm_decode(dst, nbytes, d_nrzm_last);
+                            for (size_t i=(nbytes > 16 ? nbytes - 16 : 0); i<nbytes; i++) {
+                                d_history.push_byte(dst[i]);
+                            }
+                            if (d_ambiguity == INVERTED) {
+                                for (size_t i=0; i<nbytes; i++) dst[i] ^= 0xff;
+                            }
+                        } else {
+                            pack_bits(&in[count], dst, nbytes, d_ambiguity == INVERTED);
+                            for (size_t i=(nbits > 128 ? nbits - 128 : 0); i<nbits; i++) {
+                                d_history.push(in[count + i]);
+                            }
+                        }
+                        count += nbits;
+                        d_frame_buffer_len += nbytes;
+                        if (d_frame_buffer_len == d_frame_len) {
+                            end_frame();
+                        }
+                        break;
                     }
-                    d_frame_buffer_len++;
-                    d_bit_ctr = 0;
                 }
-                if (d_frame_buffer_len == d_frame_len) {
-                    publish_msg();
-                    d_frame_count++;
-                    enter_state(SEARCH);
+                const uint8_t bit = next_bit(in[count++]);
+                d_history.push(bit);
+                if (add_frame_bit(bit)) {
+                    end_frame();
+                }
+                break;
+            }
+            case RESYNC:
+                d_history.push(next_bit(in[count++]));
+                d_resync_bits++;
+                if (d_resync_bits == d_markers[d_marker].asm_len + d_slip_window) {
+                    resync();
                 }
                 break;
             }
@@ -104,13 +179,96 @@ namespace gr {
         return noutput_items;
     }
     
-    bool correlator_impl::check_asm(const uint64_t asm_buf) {
+    bool correlator_impl::check_asm(const uint64_t asm_buf, const sync_marker &marker) {
         debug_print("check_asm\n");
 
         uint64_t nerrors = 0;
-        const uint64_t syndrome = (asm_buf ^ d_asm) & d_asm_mask;
+        const uint64_t syndrome = (asm_buf ^ marker.asm_) & marker.asm_mask;
         volk_64u_popcnt(&nerrors, syndrome);
-        return nerrors <= (uint64_t)d_threshold;
+        return nerrors <= (uint64_t)marker.threshold;
+    }
+
+    bool correlator_impl::find_asm() {
+        // every marker is tested against the same register
+        for (size_t i=0; i<d_markers.size(); i++) {
+            if (check_asm(d_asm_buf, d_markers[i])) {
+                d_ambiguity = NONE;
+            } else if (check_asm(d_asm_buf ^ 0xffffffffffffffff, d_markers[i])) {
+                d_ambiguity = INVERTED;
+            } else {
+                continue;
+            }
+            d_marker = i;
+            d_frame_len = d_markers[i].frame_len;
+            return true;
+        }
+        return false;
+    }
+
+    bool correlator_impl::add_frame_bit(const uint8_t bit) {
+        d_byte_buf = (d_byte_buf << 1) | bit;
+        d_bit_ctr++;
+        if (d_bit_ctr == 8) {
+            if (d_ambiguity == NONE) {
+                d_frame_buffer[d_frame_buffer_len] = d_byte_buf;
+            } else if (d_ambiguity == INVERTED) {
+                d_frame_buffer[d_frame_buffer_len] = d_byte_buf ^ 0xff;
+            }
+            d_frame_buffer_len++;
+            d_bit_ctr = 0;
+        }
+        return d_frame_buffer_len == d_frame_len;
+    }
+
+    void correlator_impl::end_frame() {
+        publish_msg();
+        d_frame_count++;
+        enter_state(d_slip_window > 0 ? RESYNC : SEARCH);
+    }
+
+    void correlator_impl::resync() {
+        debug_print("resync\n");
+
+        // the history now ends slip_window bits after the expected end of
+        // the asm. test every offset and both polarities, preferring the
+        // fewest errors and then the smallest slip.
+        const sync_marker &marker = d_markers[d_marker];
+        const int n = d_slip_window;
+        int best_slip = 0;
+        uint64_t best_errors = UINT64_MAX;
+        ambiguity_t best_ambiguity = NONE;
+        for (int slip=-n; slip<=n; slip++) {
+            const uint64_t buf = d_history.window(n - slip);
+            for (int inv=0; inv<2; inv++) {
+                uint64_t nerrors = 0;
+                volk_64u_popcnt(&nerrors, ((inv ? ~buf : buf) ^ marker.asm_) & marker.asm_mask);
+                if (nerrors < best_errors ||
+                    (nerrors == best_errors && abs(slip) < abs(best_slip))) {
+                    best_errors = nerrors;
+                    best_slip = slip;
+                    best_ambiguity = inv ? INVERTED : NONE;
+                }
+            }
+        }
+
+        if (best_errors > marker.threshold) {
+            // lost lock, search from the bits seen so far
+            enter_state(SEARCH);
+            d_asm_buf = d_history.lo;
+            return;
+        }
+
+        if (best_slip != 0) d_num_bit_slips++;
+        d_ambiguity = best_ambiguity;
+        enter_state(LOCK);
+
+        // the bits read past the asm already belong to the frame
+        for (int i=n - best_slip; i-- > 0; ) {
+            if (add_frame_bit((d_history.lo >> i) & 0x01)) {
+                end_frame();
+                return;
+            }
+        }
     }
 
     void correlator_impl::enter_state(const state_t state) {
@@ -125,6 +283,9 @@ namespace gr {
             d_bit_ctr = 0;
             d_frame_buffer_len = 0;
             break;
+        case RESYNC:
+            d_resync_bits = 0;
+            break;
         }
         d_state = state;
     }
@@ -135,6 +296,10 @@ namespace gr {
         pmt::pmt_t meta = pmt::make_dict();
         meta = dict_add(meta, pmt::intern("frame_count"), 
                         pmt::from_uint64(d_frame_count));
+        meta = dict_add(meta, pmt::intern("asm_index"),
+                        pmt::from_uint64(d_marker));
+        meta = dict_add(meta, pmt::intern("asm"),
+                        pmt::from_uint64(d_markers[d_marker].asm_));
         const pmt::pmt_t data = pmt::init_u8vector(d_frame_len, d_frame_buffer);
         message_port_pub(pmt::mp("out"), pmt::cons(meta, data));
     }
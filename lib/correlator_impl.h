@@ -23,15 +23,31 @@
 
 #include <gnuradio/ccsds/correlator.h>
 #include <vector>
+#include "ccsds.h"
 
 namespace gr {
   namespace ccsds {
 
     class correlator_impl : public correlator {
       private:
-        const uint64_t d_asm, d_asm_mask;
-        const uint8_t d_threshold;
-        const size_t d_frame_len;
+        struct sync_marker {
+            uint64_t asm_, asm_mask;
+            uint8_t threshold;
+            size_t frame_len;
+            int asm_len;    // bits covered by the mask
+        };
+
+        std::vector<sync_marker> d_markers;
+        size_t d_marker;    // marker of the current frame
+        size_t d_frame_len; // frame length of the current frame
+
+        const int d_slip_window;
+        bit_history d_history;
+        int d_resync_bits;
+        uint64_t d_num_bit_slips;
+
+        const bool d_nrzm;
+        uint8_t d_nrzm_last;    // last raw input bit
 
         uint64_t d_asm_buf;
         uint8_t *d_frame_buffer;
@@ -43,18 +59,33 @@ namespace gr {
         uint64_t d_frame_count;
 
       public:
-        correlator_impl(const uint64_t asm_, const uint64_t asm_mask, 
-                        const uint8_t threshold, const size_t frame_len);
+        correlator_impl(const std::vector<uint64_t> &asms,
+                        const std::vector<uint64_t> &asm_masks,
+                        const std::vector<uint8_t> &thresholds,
+                        const std::vector<size_t> &frame_lens,
+                        const int slip_window,
+                        const bool nrzm);
         ~correlator_impl(); 
         int work(int noutput_items,
            gr_vector_const_void_star &input_items,
            gr_vector_void_star &output_items);
 
-        bool check_asm(const uint64_t asm_buf);
+        uint8_t next_bit(const uint8_t raw) {
+            if (!d_nrzm) return raw & 0x01;
+            const uint8_t bit = (raw ^ d_nrzm_last) & 0x01;
+            d_nrzm_last = raw & 0x01;
+            return bit;
+        }
+        bool check_asm(const uint64_t asm_buf, const sync_marker &marker);
+        bool find_asm();
+        bool add_frame_bit(const uint8_t bit);
+        void end_frame();
+        void resync();
         void enter_state(const state_t state);
         void publish_msg();
 
         uint64_t frame_count() const;
+        uint64_t num_bit_slips() const { return d_num_bit_slips; }
     };
 
   } // namespace ccsds
@@ -0,0 +1,437 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ldpc.h"
+
+#include <string.h>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace gr {
+    namespace ccsds {
+
+        /*
+         * 32 lanes of int8 with saturating arithmetic. Magnitudes are
+         * handled as unsigned bytes so that |-128| = 128 stays representable.
+         */
+#if defined(__AVX2__)
+        struct v32 { __m256i v; };
+        static inline v32 v_load(const int8_t *p) { return { _mm256_loadu_si256((const __m256i *)p) }; }
+        static inline void v_store(int8_t *p, v32 a) { _mm256_storeu_si256((__m256i *)p, a.v); }
+        static inline v32 v_zero() { return { _mm256_setzero_si256() }; }
+        static inline v32 v_ones() { return { _mm256_set1_epi8(-1) }; }
+        static inline v32 v_adds(v32 a, v32 b) { return { _mm256_adds_epi8(a.v, b.v) }; }
+        static inline v32 v_subs(v32 a, v32 b) { return { _mm256_subs_epi8(a.v, b.v) }; }
+        static inline v32 v_sub(v32 a, v32 b) { return { _mm256_sub_epi8(a.v, b.v) }; }
+        static inline v32 v_xor(v32 a, v32 b) { return { _mm256_xor_si256(a.v, b.v) }; }
+        static inline v32 v_sign(v32 a) { return { _mm256_cmpgt_epi8(_mm256_setzero_si256(), a.v) }; }
+        static inline v32 v_eq(v32 a, v32 b) { return { _mm256_cmpeq_epi8(a.v, b.v) }; }
+        static inline v32 v_minu(v32 a, v32 b) { return { _mm256_min_epu8(a.v, b.v) }; }
+        static inline v32 v_maxu(v32 a, v32 b) { return { _mm256_max_epu8(a.v, b.v) }; }
+        static inline v32 v_select(v32 m, v32 a, v32 b) { return { _mm256_blendv_epi8(b.v, a.v, m.v) }; }
+        static inline v32 v_scale(v32 a) {
+            // 3/4 of an unsigned magnitude
+            const __m256i h = _mm256_and_si256(_mm256_srli_epi16(a.v, 1), _mm256_set1_epi8(0x7f));
+            const __m256i q = _mm256_and_si256(_mm256_srli_epi16(a.v, 2), _mm256_set1_epi8(0x3f));
+            return { _mm256_add_epi8(h, q) };
+        }
+        static inline uint32_t v_signbits(v32 a) { return _mm256_movemask_epi8(a.v); }
+#elif defined(__SSE2__)
+        struct v32 { __m128i lo, hi; };
+#define V32_OP(name, expr) \
+        static inline v32 name(v32 a, v32 b) { \
+            return { [](__m128i x, __m128i y) { return expr; }(a.lo, b.lo), \
+                     [](__m128i x, __m128i y) { return expr; }(a.hi, b.hi) }; }
+        V32_OP(v_adds, _mm_adds_epi8(x, y))
+        V32_OP(v_subs, _mm_subs_epi8(x, y))
+        V32_OP(v_sub, _mm_sub_epi8(x, y))
+        V32_OP(v_xor, _mm_xor_si128(x, y))
+        V32_OP(v_eq, _mm_cmpeq_epi8(x, y))
+        V32_OP(v_minu, _mm_min_epu8(x, y))
+        V32_OP(v_maxu, _mm_max_epu8(x, y))
+#undef V32_OP
+        static inline v32 v_load(const int8_t *p) {
+            return { _mm_loadu_si128((const __m128i *)p), _mm_loadu_si128((const __m128i *)(p + 16)) };
+        }
+        static inline void v_store(int8_t *p, v32 a) {
+            _mm_storeu_si128((__m128i *)p, a.lo);
+            _mm_storeu_si128((__m128i *)(p + 16), a.hi);
+        }
+        static inline v32 v_zero() { return { _mm_setzero_si128(), _mm_setzero_si128() }; }
+        static inline v32 v_ones() { return { _mm_set1_epi8(-1), _mm_set1_epi8(-1) }; }
+        static inline v32 v_sign(v32 a) {
+            return { _mm_cmpgt_epi8(_mm_setzero_si128(), a.lo), _mm_cmpgt_epi8(_mm_setzero_si128(), a.hi) };
+        }
+        static inline v32 v_select(v32 m, v32 a, v32 b) {
+            return { _mm_or_si128(_mm_and_si128(m.lo, a.lo), _mm_andnot_si128(m.lo, b.lo)),
+                     _mm_or_si128(_mm_and_si128(m.hi, a.hi), _mm_andnot_si128(m.hi, b.hi)) };
+        }
+        static inline __m128i scale_half(__m128i a) {
+            const __m128i h = _mm_and_si128(_mm_srli_epi16(a, 1), _mm_set1_epi8(0x7f));
+            const __m128i q = _mm_and_si128(_mm_srli_epi16(a, 2), _mm_set1_epi8(0x3f));
+            return _mm_add_epi8(h, q);
+        }
+        static inline v32 v_scale(v32 a) { return { scale_half(a.lo), scale_half(a.hi) }; }
+        static inline uint32_t v_signbits(v32 a) {
+            return (uint32_t)_mm_movemask_epi8(a.lo) | ((uint32_t)_mm_movemask_epi8(a.hi) << 16);
+        }
+#else
+        struct v32 { int8_t v[LDPC_LANES]; };
+        static inline int8_t sat8(int x) { return x > 127 ? 127 : (x < -128 ? -128 : x); }
+#define V32_OP(name, expr) \
+        static inline v32 name(v32 a, v32 b) { \
+            v32 r; \
+            for (int i=0; i<LDPC_LANES; i++) { const int8_t x = a.v[i], y = b.v[i]; r.v[i] = (expr); } \
+            return r; }
+        V32_OP(v_adds, sat8(x + y))
+        V32_OP(v_subs, sat8(x - y))
+        V32_OP(v_sub, (int8_t)(x - y))
+        V32_OP(v_xor, x ^ y)
+        V32_OP(v_eq, x == y ? -1 : 0)
+        V32_OP(v_minu, (uint8_t)x < (uint8_t)y ? x : y)
+        V32_OP(v_maxu, (uint8_t)x > (uint8_t)y ? x : y)
+#undef V32_OP
+        static inline v32 v_load(const int8_t *p) { v32 r; memcpy(r.v, p, LDPC_LANES); return r; }
+        static inline void v_store(int8_t *p, v32 a) { memcpy(p, a.v, LDPC_LANES); }
+        static inline v32 v_zero() { v32 r; memset(r.v, 0, LDPC_LANES); return r; }
+        static inline v32 v_ones() { v32 r; memset(r.v, 0xff, LDPC_LANES); return r; }
+        static inline v32 v_sign(v32 a) {
+            v32 r;
+            for (int i=0; i<LDPC_LANES; i++) r.v[i] = a.v[i] < 0 ? -1 : 0;
+            return r;
+        }
+        static inline v32 v_select(v32 m, v32 a, v32 b) {
+            v32 r;
+            for (int i=0; i<LDPC_LANES; i++) r.v[i] = m.v[i] ? a.v[i] : b.v[i];
+            return r;
+        }
+        static inline v32 v_scale(v32 a) {
+            v32 r;
+            for (int i=0; i<LDPC_LANES; i++) {
+                const uint8_t m = a.v[i];
+                r.v[i] = (m >> 1) + (m >> 2);
+            }
+            return r;
+        }
+        static inline uint32_t v_signbits(v32 a) {
+            uint32_t r = 0;
+            for (int i=0; i<LDPC_LANES; i++) r |= (uint32_t)(a.v[i] < 0) << i;
+            return r;
+        }
+#endif
+
+        static const ldpc_code_def &lookup_code(ldpc_code_t code) {
+            switch (code) {
+            case LDPC_C2:
+                return LDPC_CODE_C2;
+            }
+            throw std::runtime_error("unknown ldpc code");
+        }
+
+        ldpc::ldpc(ldpc_code_t code)
+            : d_code(lookup_code(code)), d_gen_words(0), d_par_words(0)
+        {
+            const int z = d_code.z;
+
+            // rows that are updated together must not share a variable, which
+            // holds as long as the positions within a circulant are at least
+            // LDPC_LANES apart
+            d_stride = z + LDPC_LANES;
+            d_ngroups = (z + LDPC_LANES - 1) / LDPC_LANES;
+            d_nedges = d_code.block_cols * d_code.weight;
+
+            for (int row=0; row<d_code.block_rows; row++) {
+                for (int col=0; col<d_code.block_cols; col++) {
+                    for (int w=0; w<d_code.weight; w++) {
+                        edge e;
+                        e.col = col * d_stride;
+                        e.pos = d_code.positions[(row*d_code.block_cols + col)*d_code.weight + w];
+                        d_edges.push_back(e);
+                    }
+                }
+            }
+
+            d_llr.resize(d_code.block_cols * d_stride);
+            d_msg.resize(d_code.block_rows * d_ngroups * d_nedges * LDPC_LANES);
+            d_tmp.resize((d_nedges + 1) * LDPC_LANES);
+        }
+
+        ldpc::~ldpc() {}
+
+        void ldpc::fix_wrap(int col)
+        {
+            // every block column keeps a copy of its first LDPC_LANES llrs
+            // behind its end so that wrapping lane groups load in one go
+            int8_t *c = &d_llr[col];
+            memcpy(&c[d_code.z], c, LDPC_LANES);
+        }
+
+        void ldpc::update_group(int row, int group)
+        {
+            const int z = d_code.z;
+            const int r0 = group * LDPC_LANES;
+            const int n = std::min(LDPC_LANES, z - r0);
+            const edge *edges = &d_edges[row * d_nedges];
+            int8_t *msg = &d_msg[((size_t)row * d_ngroups + group) * d_nedges * LDPC_LANES];
+            int8_t *q = d_tmp.data();
+
+            // variable to check messages, and the two smallest magnitudes
+            v32 min1 = v_ones();
+            v32 min2 = v_ones();
+            v32 sign = v_zero();
+            for (int e=0; e<d_nedges; e++) {
+                const int8_t *l = &d_llr[edges[e].col + (edges[e].pos + r0) % z];
+                const v32 qe = v_subs(v_load(l), v_load(&msg[e*LDPC_LANES]));
+                v_store(&q[e*LDPC_LANES], qe);
+
+                const v32 s = v_sign(qe);
+                const v32 m = v_sub(v_xor(qe, s), s);
+                sign = v_xor(sign, s);
+                min2 = v_minu(min2, v_maxu(min1, m));
+                min1 = v_minu(min1, m);
+            }
+
+            // normalized min-sum check to variable messages
+            const v32 min1s = v_scale(min1);
+            const v32 min2s = v_scale(min2);
+            int8_t *partial = &d_tmp[d_nedges * LDPC_LANES];
+            for (int e=0; e<d_nedges; e++) {
+                const v32 qe = v_load(&q[e*LDPC_LANES]);
+                const v32 s = v_sign(qe);
+                const v32 m = v_sub(v_xor(qe, s), s);
+                const v32 mag = v_select(v_eq(m, min1), min2s, min1s);
+                const v32 sg = v_xor(sign, s);
+                const v32 r = v_sub(v_xor(mag, sg), sg);
+                v_store(&msg[e*LDPC_LANES], r);
+
+                const int start = (edges[e].pos + r0) % z;
+                int8_t *l = &d_llr[edges[e].col + start];
+                if (n == LDPC_LANES) {
+                    v_store(l, v_adds(qe, r));
+                } else {
+                    // the last group of a circulant has fewer rows than lanes
+                    v_store(partial, v_adds(qe, r));
+                    memcpy(l, partial, n);
+                }
+                if (start + n > z) {
+                    memcpy(&d_llr[edges[e].col], &d_llr[edges[e].col + z], start + n - z);
+                }
+                if (start < LDPC_LANES || start + n > z) {
+                    fix_wrap(edges[e].col);
+                }
+            }
+        }
+
+        bool ldpc::check_parity()
+        {
+            const int z = d_code.z;
+            for (int row=0; row<d_code.block_rows; row++) {
+                const edge *edges = &d_edges[row * d_nedges];
+                for (int group=0; group<d_ngroups; group++) {
+                    const int r0 = group * LDPC_LANES;
+                    const int n = std::min(LDPC_LANES, z - r0);
+                    v32 acc = v_zero();
+                    for (int e=0; e<d_nedges; e++) {
+                        acc = v_xor(acc, v_load(&d_llr[edges[e].col + (edges[e].pos + r0) % z]));
+                    }
+                    const uint32_t lanes = n == 32 ? 0xffffffff : ((1u << n) - 1);
+                    if (v_signbits(acc) & lanes) return false;
+                }
+            }
+            return true;
+        }
+
+        bool ldpc::decode(const int8_t *llr, uint8_t *info,
+                          int max_iterations, int &iterations)
+        {
+            const int z = d_code.z;
+
+            // the virtual fill bits are known zeros, the appended tail bits
+            // are not part of the code
+            int n = 0;
+            for (int col=0; col<d_code.block_cols; col++) {
+                int8_t *c = &d_llr[col * d_stride];
+                for (int k=0; k<z; k++, n++) {
+                    c[k] = n < d_code.fill ? 127 : llr[n - d_code.fill];
+                }
+                fix_wrap(col * d_stride);
+            }
+            memset(d_msg.data(), 0, d_msg.size());
+
+            iterations = 0;
+            bool success = check_parity();
+            while (!success && iterations < max_iterations) {
+                for (int row=0; row<d_code.block_rows; row++) {
+                    for (int group=0; group<d_ngroups; group++) {
+                        update_group(row, group);
+                    }
+                }
+                iterations++;
+                success = check_parity();
+            }
+
+            memset(info, 0, d_code.info_len / 8);
+            for (int i=0; i<d_code.info_len; i++) {
+                const int bit = d_code.fill + i;
+                if (d_llr[(bit / z) * d_stride + bit % z] < 0) {
+                    info[i >> 3] |= 0x80 >> (i & 0x07);
+                }
+            }
+            return success;
+        }
+
+        void ldpc::init_encoder()
+        {
+            if (!d_gen.empty()) return;
+
+            const int z = d_code.z;
+            const int nsys = d_code.systematic_cols;
+            const int npar = (d_code.block_cols - nsys) * z;
+            const int nrows = d_code.block_rows * z;
+
+            // augmented system [Hp | h_0 .. h_nsys-1], where h_j is the first
+            // column of systematic block column j. the parity bits of every
+            // other information bit follow by cyclic shifts.
+            const int ncols = npar + nsys;
+            const int words = (ncols + 63) / 64;
+            std::vector<uint64_t> m((size_t)nrows * words, 0);
+            for (int row=0; row<d_code.block_rows; row++) {
+                for (int col=0; col<d_code.block_cols; col++) {
+                    for (int w=0; w<d_code.weight; w++) {
+                        const int pos = d_code.positions[(row*d_code.block_cols + col)*d_code.weight + w];
+                        for (int k=0; k<z; k++) {
+                            uint64_t *r = &m[(size_t)(row*z + k) * words];
+                            const int m_col = (pos + k) % z;
+                            int bit;
+                            if (col >= nsys) {
+                                bit = (col - nsys) * z + m_col;
+                            } else if (m_col == 0) {
+                                bit = npar + col;
+                            } else {
+                                continue;
+                            }
+                            r[bit >> 6] ^= (uint64_t)1 << (bit & 63);
+                        }
+                    }
+                }
+            }
+
+            // gauss-jordan elimination over GF(2)
+            std::vector<int> pivots;
+            int rank = 0;
+            for (int col=0; col<npar && rank<nrows; col++) {
+                const uint64_t bit = (uint64_t)1 << (col & 63);
+                int sel = rank;
+                while (sel < nrows && !(m[(size_t)sel*words + (col >> 6)] & bit)) sel++;
+                if (sel == nrows) continue;
+
+                uint64_t *p = &m[(size_t)rank*words];
+                if (sel != rank) std::swap_ranges(p, p + words, &m[(size_t)sel*words]);
+                for (int i=0; i<nrows; i++) {
+                    uint64_t *r = &m[(size_t)i*words];
+                    if (i != rank && (r[col >> 6] & bit)) {
+                        for (int w=0; w<words; w++) r[w] ^= p[w];
+                    }
+                }
+                pivots.push_back(col);
+                rank++;
+            }
+            for (int i=rank; i<nrows; i++) {
+                for (int j=0; j<nsys; j++) {
+                    const int bit = npar + j;
+                    if (m[(size_t)i*words + (bit >> 6)] & ((uint64_t)1 << (bit & 63))) {
+                        throw std::runtime_error("ldpc code has no systematic encoder");
+                    }
+                }
+            }
+
+            // parity bits without a pivot are free and left at zero. for C2
+            // these are the last bit of each parity circulant, which gives
+            // the quasi-cyclic generator of CCSDS 131.0-B bit for bit.
+
+            // store the first row of every generator circulant twice in a
+            // row, so that any cyclic shift is a window of consecutive bits
+            const int nblocks = d_code.block_cols - nsys;
+            d_par_words = (z + 63) / 64;
+            d_gen_words = (2*z + 63) / 64 + 1;
+            d_gen.assign((size_t)nsys * nblocks * d_gen_words, 0);
+            d_par.assign((size_t)nblocks * d_par_words, 0);
+            for (int j=0; j<nsys; j++) {
+                const int rhs = npar + j;
+                for (int i=0; i<rank; i++) {
+                    if (!(m[(size_t)i*words + (rhs >> 6)] & ((uint64_t)1 << (rhs & 63)))) continue;
+                    const int b = pivots[i] / z;
+                    const int k = pivots[i] % z;
+                    uint64_t *g = &d_gen[((size_t)j*nblocks + b) * d_gen_words];
+                    g[k >> 6] |= (uint64_t)1 << (k & 63);
+                    g[(k + z) >> 6] |= (uint64_t)1 << ((k + z) & 63);
+                }
+            }
+        }
+
+        void ldpc::encode(const uint8_t *info, uint8_t *codeblock)
+        {
+            init_encoder();
+
+            const int z = d_code.z;
+            const int nblocks = d_code.block_cols - d_code.systematic_cols;
+            std::fill(d_par.begin(), d_par.end(), 0);
+
+            // parity of information bit r of block column j is the generator
+            // row of j rotated by r, i.e. bits [z - r, 2z - r) of the doubled row
+            for (int i=0; i<d_code.info_len; i++) {
+                if (!((info[i >> 3] >> (7 - (i & 0x07))) & 0x01)) continue;
+                const int n = d_code.fill + i;
+                const int j = n / z;
+                const int off = z - n % z;
+                const int s = off & 63;
+                for (int b=0; b<nblocks; b++) {
+                    const uint64_t *g = &d_gen[((size_t)j*nblocks + b) * d_gen_words + (off >> 6)];
+                    uint64_t *p = &d_par[(size_t)b * d_par_words];
+                    if (s == 0) {
+                        for (int w=0; w<d_par_words; w++) p[w] ^= g[w];
+                    } else {
+                        for (int w=0; w<d_par_words; w++) p[w] ^= (g[w] >> s) | (g[w+1] << (64 - s));
+                    }
+                }
+            }
+
+            const int frame_bytes = d_code.frame_len / 8;
+            memset(codeblock, 0, frame_bytes);
+            memcpy(codeblock, info, d_code.info_len / 8);
+            int bit = d_code.info_len;
+            for (int b=0; b<nblocks; b++) {
+                const uint64_t *p = &d_par[(size_t)b * d_par_words];
+                for (int k=0; k<z; k++, bit++) {
+                    if ((p[k >> 6] >> (k & 63)) & 0x01) {
+                        codeblock[bit >> 3] |= 0x80 >> (bit & 0x07);
+                    }
+                }
+            }
+        }
+
+    }
+}
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LDPC_H
+#define INCLUDED_LDPC_H
+
+#include <gnuradio/ccsds/api.h>
+#include <gnuradio/ccsds/ldpc_code.h>
+#include <stdint.h>
+#include <vector>
+#include "ldpc_codes.h"
+
+// number of check rows updated at once, one per int8 lane
+#define LDPC_LANES 32
+
+namespace gr {
+    namespace ccsds {
+
+        class CCSDS_API ldpc {
+            private:
+                struct edge {
+                    int col;  // offset of the block column in d_llr
+                    int pos;  // circulant position
+                };
+
+                const ldpc_code_def &d_code;
+                int d_stride;   // block column length in d_llr, incl. wrap copy
+                int d_ngroups;  // lane groups per block row
+                int d_nedges;   // edges per check row
+
+                std::vector<edge> d_edges;     // [block_rows][nedges]
+                std::vector<int8_t> d_llr;     // posterior llrs per code bit
+                std::vector<int8_t> d_msg;     // check to variable messages
+                std::vector<int8_t> d_tmp;     // per edge scratch for a group
+
+                int d_gen_words;               // words per doubled generator row
+                int d_par_words;               // words per parity block column
+                std::vector<uint64_t> d_gen;   // [systematic_cols][parity cols]
+                std::vector<uint64_t> d_par;   // parity accumulator
+
+                void update_group(int row, int group);
+                bool check_parity();
+                void fix_wrap(int col);
+
+            public:
+                ldpc(ldpc_code_t code);
+                ~ldpc();
+
+                int info_len() const { return d_code.info_len; }
+                int frame_len() const { return d_code.frame_len; }
+
+                /*
+                 * decode one codeblock of frame_len() llrs (positive means
+                 * zero) into info_len()/8 packed bytes. returns true if all
+                 * parity checks are satisfied, and the number of iterations
+                 * used in iterations.
+                 */
+                bool decode(const int8_t *llr, uint8_t *info,
+                            int max_iterations, int &iterations);
+
+                /*
+                 * build the generator used by encode(). done on the first
+                 * call to encode() unless called before.
+                 */
+                void init_encoder();
+
+                /*
+                 * encode info_len()/8 packed bytes into a codeblock of
+                 * frame_len()/8 packed bytes, information bits first.
+                 */
+                void encode(const uint8_t *info, uint8_t *codeblock);
+        };
+
+    }
+}
+
+#endif /* INCLUDED_LDPC_H */
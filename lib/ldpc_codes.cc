@@ -0,0 +1,45 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ldpc_codes.h"
+
+// circulant positions of the C2 parity check matrix, CCSDS 131.0-B section 7
+static const uint16_t C2_POSITIONS[2*16*2] = {
+    // A1,1 .. A1,16
+      0, 176,   12, 239,    0, 352,   24, 431,    0, 392,  151, 409,    0, 351,    9, 359,
+      0, 307,   53, 329,    0, 207,   18, 281,    0, 399,  202, 457,    0, 247,   36, 261,
+    // A2,1 .. A2,16
+     99, 471,  130, 473,  198, 435,  260, 478,  215, 420,  282, 481,   48, 396,  193, 445,
+    273, 430,  302, 451,   96, 379,  191, 386,  244, 467,  364, 470,   51, 382,  192, 414,
+};
+
+const ldpc_code_def LDPC_CODE_C2 = {
+    "C2",
+    511,            // z
+    2,              // block_rows
+    16,             // block_cols
+    2,              // weight
+    C2_POSITIONS,
+    14,             // systematic_cols
+    18,             // fill
+    2,              // tail
+    7136,           // info_len
+    8160,           // frame_len
+};
@@ -0,0 +1,56 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __LDPC_CODES_H__
+#define __LDPC_CODES_H__
+
+#include <stdint.h>
+
+/*
+ * Quasi-cyclic LDPC code described by its parity check matrix. The matrix
+ * is made of block_rows x block_cols circulants of size z, each given by
+ * the positions of the ones in its first row. Row r of a circulant has its
+ * ones at (position + r) mod z.
+ *
+ * The transmitted codeblock drops the first fill bits of the code (which
+ * are always zero) and appends tail zero bits at the end.
+ */
+struct ldpc_code_def {
+    const char *name;
+    int z;
+    int block_rows;
+    int block_cols;
+    int weight;               // ones per circulant row
+    const uint16_t *positions; // [block_rows][block_cols][weight]
+    int systematic_cols;      // block columns carrying information
+    int fill;                 // leading virtual fill bits
+    int tail;                 // trailing zero bits
+    int info_len;             // transmitted information bits
+    int frame_len;            // transmitted codeblock bits
+};
+
+// (8160,7136) near earth code from CCSDS 131.0-B, shortened from (8176,7154)
+extern const ldpc_code_def LDPC_CODE_C2;
+
+// the AR4JA codes need a punctured column and a permutation table per
+// circulant, neither of which ldpc_code_def describes yet
+
+#endif // __LDPC_CODES_H__
@@ -0,0 +1,161 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <math.h>
+#include <gnuradio/io_signature.h>
+#include "ldpc_decoder_impl.h"
+#include "ccsds.h"
+
+// llr magnitude of hard decision input
+#define LDPC_HARD_LLR 32
+// soft input is scaled so that its mean magnitude maps to this llr
+#define LDPC_SOFT_LLR 16.0f
+
+namespace gr {
+  namespace ccsds {
+
+    ldpc_decoder::sptr
+    ldpc_decoder::make(ldpc_code_t code, int max_iterations, bool descramble)
+    {
+      return gnuradio::get_initial_sptr
+        (new ldpc_decoder_impl(code, max_iterations, descramble));
+    }
+
+    ldpc_decoder_impl::ldpc_decoder_impl(ldpc_code_t code, int max_iterations, bool descramble)
+      : gr::block("ldpc_decoder",
+              gr::io_signature::make(0, 0, 0),
+              gr::io_signature::make(0, 0, 0)),
+        d_max_iterations(max_iterations),
+        d_descramble(descramble),
+        d_num_frames_decoded(0),
+        d_num_frames_failed(0),
+        d_num_iterations(0),
+        d_ldpc(code)
+    {
+      d_llr.resize(d_ldpc.frame_len());
+      d_info.resize(d_ldpc.info_len() / 8);
+
+      message_port_register_out(pmt::mp("out"));
+      message_port_register_in(pmt::mp("in"));
+      set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->handle_msg(msg); });
+    }
+
+    ldpc_decoder_impl::~ldpc_decoder_impl()
+    {
+    }
+
+    float ldpc_decoder_impl::average_iterations() const
+    {
+        const uint64_t nframes = d_num_frames_decoded + d_num_frames_failed;
+        return nframes ? (float)d_num_iterations / nframes : 0.0f;
+    }
+
+    static inline int8_t clamp_llr(float llr)
+    {
+        if (llr > 127.0f) return 127;
+        if (llr < -127.0f) return -127;
+        return (int8_t)lrintf(llr);
+    }
+
+    bool ldpc_decoder_impl::load_llrs(pmt::pmt_t vec)
+    {
+        const size_t frame_len = d_ldpc.frame_len();
+        size_t len = 0;
+
+        if (pmt::is_u8vector(vec)) {
+            const uint8_t *in = pmt::u8vector_elements(vec, len);
+            if (len != frame_len / 8) {
+                printf("[ERROR] expected %i bytes, got %i\n", (int)(frame_len / 8), (int)len);
+                return false;
+            }
+            for (size_t i=0; i<frame_len; i++) {
+                uint8_t bit = (in[i >> 3] >> (7 - (i & 0x07))) & 0x01;
+                if (d_descramble) bit ^= scrambler_bit(i);
+                d_llr[i] = bit ? -LDPC_HARD_LLR : LDPC_HARD_LLR;
+            }
+            return true;
+        }
+
+        if (pmt::is_f32vector(vec) || pmt::is_s8vector(vec)) {
+            std::vector<float> soft(frame_len);
+            if (pmt::is_f32vector(vec)) {
+                const float *in = pmt::f32vector_elements(vec, len);
+                if (len == frame_len) memcpy(soft.data(), in, frame_len * sizeof(float));
+            } else {
+                const int8_t *in = pmt::s8vector_elements(vec, len);
+                if (len == frame_len) {
+                    for (size_t i=0; i<frame_len; i++) soft[i] = in[i];
+                }
+            }
+            if (len != frame_len) {
+                printf("[ERROR] expected %i soft symbols, got %i\n", (int)frame_len, (int)len);
+                return false;
+            }
+
+            float mean = 0.0f;
+            for (size_t i=0; i<frame_len; i++) mean += fabsf(soft[i]);
+            mean /= frame_len;
+            const float scale = mean > 0.0f ? LDPC_SOFT_LLR / mean : 0.0f;
+
+            // positive soft symbols are ones, positive llrs are zeros
+            for (size_t i=0; i<frame_len; i++) {
+                float llr = -soft[i] * scale;
+                if (d_descramble && scrambler_bit(i)) llr = -llr;
+                d_llr[i] = clamp_llr(llr);
+            }
+            return true;
+        }
+
+        printf("[ERROR] unsupported codeblock vector type\n");
+        return false;
+    }
+
+    void ldpc_decoder_impl::handle_msg(pmt::pmt_t msg)
+    {
+        if (!pmt::is_pair(msg)) {
+            throw std::runtime_error("received a malformed pdu message");
+        }
+        if (!load_llrs(pmt::cdr(msg))) return;
+
+        int iterations = 0;
+        bool success = d_ldpc.decode(d_llr.data(), d_info.data(), d_max_iterations, iterations);
+        d_num_iterations += iterations;
+
+        if (!success) {
+            d_num_frames_failed++;
+            return;
+        }
+        d_num_frames_decoded++;
+
+        pmt::pmt_t meta = pmt::car(msg);
+        if (!pmt::is_dict(meta)) meta = pmt::make_dict();
+        meta = pmt::dict_add(meta, pmt::intern("iterations"), pmt::from_long(iterations));
+
+        const pmt::pmt_t data = pmt::init_u8vector(d_info.size(), d_info.data());
+        message_port_pub(pmt::mp("out"), pmt::cons(meta, data));
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_LDPC_DECODER_IMPL_H
+#define INCLUDED_CCSDS_LDPC_DECODER_IMPL_H
+
+#include <gnuradio/ccsds/ldpc_decoder.h>
+#include <vector>
+#include "ldpc.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class ldpc_decoder_impl : public ldpc_decoder
+    {
+     private:
+         const int d_max_iterations;
+         const bool d_descramble;
+
+         uint64_t d_num_frames_decoded;
+         uint64_t d_num_frames_failed;
+         uint64_t d_num_iterations;
+
+         ldpc d_ldpc;
+         std::vector<int8_t> d_llr;
+         std::vector<uint8_t> d_info;
+
+         bool load_llrs(pmt::pmt_t vec);
+         void handle_msg(pmt::pmt_t msg);
+
+     public:
+      ldpc_decoder_impl(ldpc_code_t code, int max_iterations, bool descramble);
+      ~ldpc_decoder_impl();
+
+      uint64_t num_frames_decoded() const { return d_num_frames_decoded; }
+      uint64_t num_frames_failed() const { return d_num_frames_failed; }
+      float average_iterations() const;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_LDPC_DECODER_IMPL_H */
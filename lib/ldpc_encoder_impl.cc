@@ -0,0 +1,151 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <gnuradio/io_signature.h>
+#include "ldpc_encoder_impl.h"
+
+namespace gr {
+  namespace ccsds {
+
+    ldpc_encoder::sptr
+    ldpc_encoder::make(size_t itemsize, const std::string& len_tag_key, ldpc_code_t code, bool scramble, bool printing, bool verbose)
+    {
+      return gnuradio::get_initial_sptr
+        (new ldpc_encoder_impl(itemsize, len_tag_key, code, scramble, printing, verbose));
+    }
+
+    /*
+     * The private constructor
+     */
+    ldpc_encoder_impl::ldpc_encoder_impl(size_t itemsize, const std::string& len_tag_key, ldpc_code_t code, bool scramble, bool printing, bool verbose)
+      : gr::tagged_stream_block("ldpc_encoder",
+              gr::io_signature::make(itemsize==0 ? 0:1, itemsize==0 ? 0:1, itemsize),
+              gr::io_signature::make(1, 1, sizeof(uint8_t)), len_tag_key),
+        d_itemsize(itemsize),
+        d_scramble(scramble),
+        d_printing(printing),
+        d_verbose(verbose),
+        d_num_frames(0),
+        d_curr_len(0),
+        d_ldpc(code)
+    {
+      if (d_itemsize == 0) {
+          message_port_register_in(pmt::mp("in"));
+      }
+
+      if (codeword_len() > CODEWORD_MAX_LEN) {
+          throw std::runtime_error("ldpc codeblock does not fit in a frame");
+      }
+      set_min_output_buffer(OUTPUT_BUFFER_FRAMES * total_frame_len());
+
+      // build the generator up front rather than on the first frame
+      d_ldpc.init_encoder();
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    ldpc_encoder_impl::~ldpc_encoder_impl()
+    {
+
+    }
+
+    int
+    ldpc_encoder_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+        // copy from message queue
+        if (d_itemsize == 0) {
+
+            if (d_curr_len != 0) return 0;
+
+            pmt::pmt_t msg(delete_head_nowait(pmt::mp("in")));
+            if (msg.get() == NULL) {
+                return 0;
+            }
+            if (!pmt::is_pair(msg)) {
+                throw std::runtime_error("received a malformed pdu message");
+            }
+            d_curr_meta = pmt::car(msg);
+            d_curr_vec = pmt::cdr(msg);
+            d_curr_len = pmt::length(d_curr_vec);
+        }
+        return total_frame_len();
+    }
+
+    int
+    ldpc_encoder_impl::work (int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items)
+    {
+
+      const uint8_t* in;
+      if (d_itemsize == 0) {
+          // see if there is anything to do
+          if (d_curr_len == 0) return 0;
+
+          if (d_curr_len != data_len()) {
+              printf("[ERROR] expected %i bytes, got %i\n", data_len(), (int)d_curr_len);
+              d_curr_len = 0;
+              return 0;
+          }
+
+          size_t len = 0;
+          in = (const uint8_t*) uniform_vector_elements(d_curr_vec, len);
+      } else {
+          if (ninput_items[0] != data_len()) {
+              printf("[ERROR] expected %i bytes, got %i\n", data_len(), ninput_items[0]);
+              return 0;
+          }
+          in = (const uint8_t*) input_items[0];
+      }
+      uint8_t *out = (uint8_t *) output_items[0];
+
+      // the codeblock is encoded and scrambled in place after the asm
+      memcpy(out, SYNC_WORD, SYNC_WORD_LEN);
+      uint8_t *codeword = &out[SYNC_WORD_LEN];
+      d_ldpc.encode(in, codeword);
+
+      if (d_scramble) {
+          scramble(codeword, codeword_len());
+      }
+
+      d_num_frames++;
+      if (d_verbose) {
+          printf("sending %i bytes of data\n", total_frame_len());
+          printf("number of frames transmitted: %i\n", d_num_frames);
+      }
+
+      if (d_printing) {
+          print_bytes(codeword, codeword_len());
+      }
+
+      // reset state
+      d_curr_len = 0;
+      return total_frame_len();
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_LDPC_ENCODER_IMPL_H
+#define INCLUDED_CCSDS_LDPC_ENCODER_IMPL_H
+
+#include <gnuradio/ccsds/ldpc_encoder.h>
+#include "ccsds.h"
+#include "ldpc.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class ldpc_encoder_impl : public ldpc_encoder
+    {
+     private:
+         size_t d_itemsize;
+         bool d_scramble;
+         bool d_printing;
+         bool d_verbose;
+
+         uint32_t d_num_frames;
+
+         pmt::pmt_t d_curr_meta;
+         pmt::pmt_t d_curr_vec;
+         size_t d_curr_len;
+
+         ldpc d_ldpc;
+
+         int data_len() { return d_ldpc.info_len() / 8; }
+         int codeword_len() { return d_ldpc.frame_len() / 8; }
+         int total_frame_len() { return SYNC_WORD_LEN + codeword_len(); }
+
+     protected:
+      int calculate_output_stream_length(const gr_vector_int &ninput_items);
+
+     public:
+      ldpc_encoder_impl(size_t itemsize, const std::string& len_tag_key, ldpc_code_t code, bool scramble, bool printing, bool verbose);
+      ~ldpc_encoder_impl();
+
+      uint32_t num_frames() const {return d_num_frames;}
+
+      // Where all the action really happens
+      int work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_LDPC_ENCODER_IMPL_H */
@@ -0,0 +1,247 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include "multichannel_decoder_impl.h"
+
+namespace gr {
+  namespace ccsds {
+
+    multichannel_decoder::sptr
+    multichannel_decoder::make(int n_channels, int threshold, bool rs_decode, bool descramble, bool deinterleave, int n_interleave, bool dual_basis, int n_threads, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors)
+    {
+      return gnuradio::get_initial_sptr
+        (new multichannel_decoder_impl(n_channels, threshold, rs_decode, descramble, deinterleave, n_interleave, dual_basis, n_threads, nrzm, asm_, asm_mask, rs_e, virtual_fill, check_fecf, drop_fecf_errors));
+    }
+
+    multichannel_decoder_impl::multichannel_decoder_impl(int n_channels, int threshold, bool rs_decode, bool descramble, bool deinterleave, int n_interleave, bool dual_basis, int n_threads, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors)
+      : gr::sync_block("multichannel_decoder",
+              gr::io_signature::make(n_channels, n_channels, sizeof(uint8_t)),
+              gr::io_signature::make(0, 0, 0)),
+        d_n_channels(n_channels),
+        d_threshold(threshold),
+        d_rs_decode(rs_decode),
+        d_descramble(descramble),
+        d_deinterleave(deinterleave),
+        d_n_interleave(n_interleave),
+        d_dual_basis(dual_basis),
+        d_nrzm(nrzm),
+        d_asm(asm_),
+        d_asm_mask(asm_mask),
+        d_asm_len(asm_mask ? 64 - __builtin_clzll(asm_mask) : 0),
+        d_check_fecf(check_fecf),
+        d_drop_fecf_errors(drop_fecf_errors),
+        d_channels(n_channels > 0 ? n_channels : 0),
+        d_rs(rs_e, virtual_fill),
+        d_next_seq(0),
+        d_next_pub(0),
+        d_pool(n_threads < 0 ? 1 : n_threads)
+    {
+      if (n_channels < 1) {
+          throw std::runtime_error("n_channels must be at least 1");
+      }
+      if (n_interleave < 1 || n_interleave > RS_MAX_NBLOCKS) {
+          throw std::runtime_error("n_interleave must be between 1 and 8");
+      }
+      if (asm_mask == 0) {
+          throw std::runtime_error("asm_mask must not be zero");
+      }
+      if (threshold < 0 || threshold >= d_asm_len) {
+          throw std::runtime_error("threshold must be between 0 and the asm length - 1");
+      }
+
+      size_t ring_len = 1;
+      while (ring_len < (size_t)(8*codeword_len() + 1)) ring_len <<= 1;
+      d_ring_mask = ring_len - 1;
+      for (size_t i=0; i<d_channels.size(); i++) {
+          channel &c = d_channels[i];
+          c.ring.resize(ring_len);
+          c.written = 0;
+          c.search_reg = 0;
+          c.nrzm_last = 0;
+          c.last_end = 0;
+          c.num_frames_received = 0;
+          c.num_frames_decoded = 0;
+          c.num_false_locks = 0;
+          c.num_fecf_errors = 0;
+      }
+
+      // bound the number of codewords queued up behind the workers
+      d_max_pending = 2 * d_pool.num_threads();
+
+      message_port_register_out(pmt::mp("out"));
+    }
+
+    multichannel_decoder_impl::~multichannel_decoder_impl()
+    {
+    }
+
+    uint64_t multichannel_decoder_impl::num_frames_received(int channel) const
+    {
+        if (channel < 0 || channel >= d_n_channels) return 0;
+        return d_channels[channel].num_frames_received;
+    }
+
+    uint64_t multichannel_decoder_impl::num_frames_decoded(int channel) const
+    {
+        if (channel < 0 || channel >= d_n_channels) return 0;
+        return d_channels[channel].num_frames_decoded;
+    }
+
+    uint64_t multichannel_decoder_impl::num_false_locks(int channel) const
+    {
+        if (channel < 0 || channel >= d_n_channels) return 0;
+        return d_channels[channel].num_false_locks;
+    }
+
+    uint64_t multichannel_decoder_impl::num_fecf_errors(int channel) const
+    {
+        if (channel < 0 || channel >= d_n_channels) return 0;
+        return d_channels[channel].num_fecf_errors;
+    }
+
+    bool multichannel_decoder_impl::stop()
+    {
+        d_pool.wait_idle();
+        return true;
+    }
+
+    int
+    multichannel_decoder_impl::work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      const uint64_t codeword_bits = 8*codeword_len();
+
+      for (int ch=0; ch<d_n_channels; ch++) {
+          const uint8_t *in = (const uint8_t *) input_items[ch];
+          channel &c = d_channels[ch];
+
+          for (int i=0; i<noutput_items; i++) {
+              uint8_t bit = in[i] & 0x01;
+              if (d_nrzm) {
+                  // a change of level is a one
+                  const uint8_t raw = bit;
+                  bit ^= c.nrzm_last;
+                  c.nrzm_last = raw;
+              }
+              c.ring[c.written & d_ring_mask] = bit;
+              c.written++;
+
+              c.search_reg = (c.search_reg << 1) | bit;
+              uint64_t nwrong = 0;
+              volk_64u_popcnt(&nwrong, (c.search_reg ^ d_asm) & d_asm_mask);
+              if (nwrong <= d_threshold) {
+                  c.candidates.push_back(c.written);
+              }
+
+              if (!c.candidates.empty() && c.written - c.candidates.front() == codeword_bits) {
+                  const uint64_t start = c.candidates.front();
+                  c.candidates.pop_front();
+                  // without rs decoding there is no way to tell a false
+                  // lock, so sync words inside a codeword are ignored
+                  if (d_rs_decode || start >= c.last_end) {
+                      c.last_end = c.written;
+                      submit_codeword(ch, start);
+                  }
+              }
+          }
+      }
+      return noutput_items;
+    }
+
+    void
+    multichannel_decoder_impl::submit_codeword(int ch, uint64_t start)
+    {
+        channel &c = d_channels[ch];
+        c.num_frames_received++;
+
+        std::shared_ptr<std::vector<uint8_t>> codeword =
+            std::make_shared<std::vector<uint8_t>>(codeword_len());
+        uint64_t pos = start;
+        for (int i=0; i<codeword_len(); i++) {
+            uint8_t byte = 0;
+            for (int j=0; j<8; j++) {
+                byte = (byte << 1) | c.ring[pos++ & d_ring_mask];
+            }
+            (*codeword)[i] = byte;
+        }
+
+        uint64_t seq;
+        {
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_cond.wait(lock, [this] { return d_next_seq - d_next_pub < d_max_pending; });
+            seq = d_next_seq++;
+        }
+        d_pool.submit([this, seq, ch, codeword] { decode_codeword(seq, ch, codeword); });
+    }
+
+    void
+    multichannel_decoder_impl::decode_codeword(uint64_t seq, int ch,
+                                               std::shared_ptr<std::vector<uint8_t>> codeword)
+    {
+        channel &c = d_channels[ch];
+        std::vector<uint8_t> payload(data_len());
+        int nerrors;
+        const int ndecoded = d_rs.decode_codeword(codeword->data(), payload.data(), d_n_interleave,
+                                                  d_deinterleave, d_descramble, d_rs_decode,
+                                                  d_dual_basis, nerrors);
+
+        pmt::pmt_t pdu = pmt::PMT_NIL;
+        if (ndecoded == -1) {
+            c.num_false_locks++;
+        } else if (ndecoded == d_n_interleave) {
+            c.num_frames_decoded++;
+            pmt::pmt_t meta = pmt::make_dict();
+            meta = pmt::dict_add(meta, pmt::intern("channel"), pmt::from_long(ch));
+            bool fecf_ok = true;
+            if (d_check_fecf) {
+                // the crc over a frame that ends in its fecf is zero
+                fecf_ok = crc16(payload.data(), payload.size()) == 0;
+                if (!fecf_ok) c.num_fecf_errors++;
+                meta = pmt::dict_add(meta, pmt::mp("fecf_ok"), pmt::from_bool(fecf_ok));
+            }
+            if (fecf_ok || !d_drop_fecf_errors) {
+                pdu = pmt::cons(meta, pmt::make_blob(payload.data(), payload.size()));
+            }
+        }
+
+        // publish in the order the codewords were received
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_done[seq] = pdu;
+        while (!d_done.empty() && d_done.begin()->first == d_next_pub) {
+            if (!pmt::eq(d_done.begin()->second, pmt::PMT_NIL)) {
+                message_port_pub(pmt::mp("out"), d_done.begin()->second);
+            }
+            d_done.erase(d_done.begin());
+            d_next_pub++;
+        }
+        d_cond.notify_all();
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CCSDS_MULTICHANNEL_DECODER_IMPL_H
+#define INCLUDED_CCSDS_MULTICHANNEL_DECODER_IMPL_H
+
+#include <gnuradio/ccsds/multichannel_decoder.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ccsds.h"
+#include "reed_solomon.h"
+#include "worker_pool.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class multichannel_decoder_impl : public multichannel_decoder
+    {
+     private:
+         struct channel {
+             // recent input bits, long enough for one codeword
+             std::vector<uint8_t> ring;
+             uint64_t written;
+             uint64_t search_reg;
+             uint8_t nrzm_last;  // last raw input bit
+             // first bits after sync words, waiting for their codeword
+             std::deque<uint64_t> candidates;
+             // end of the last codeword taken from this channel
+             uint64_t last_end;
+
+             std::atomic<uint64_t> num_frames_received;
+             std::atomic<uint64_t> num_frames_decoded;
+             std::atomic<uint64_t> num_false_locks;
+             std::atomic<uint64_t> num_fecf_errors;
+         };
+
+         const int d_n_channels;
+         const uint8_t d_threshold;
+         const bool d_rs_decode;
+         const bool d_descramble;
+         const bool d_deinterleave;
+         const int d_n_interleave;
+         const bool d_dual_basis;
+         const bool d_nrzm;
+         const uint64_t d_asm;
+         const uint64_t d_asm_mask;
+         const int d_asm_len;    // bits covered by the mask
+         const bool d_check_fecf;
+         const bool d_drop_fecf_errors;
+
+         uint64_t d_ring_mask;
+         std::vector<channel> d_channels;
+         reed_solomon d_rs;
+
+         std::mutex d_mutex;
+         std::condition_variable d_cond;
+         // decoded frames waiting for the frames before them, nil if dropped
+         std::map<uint64_t, pmt::pmt_t> d_done;
+         uint64_t d_next_seq;
+         uint64_t d_next_pub;
+         uint64_t d_max_pending;
+
+         // destroyed first, so running decodes finish while the rest is alive
+         worker_pool d_pool;
+
+         int data_len() const { return d_rs.data_len() * d_n_interleave; }
+         int codeword_len() const { return d_rs.block_len() * d_n_interleave; }
+
+         void submit_codeword(int ch, uint64_t start);
+         void decode_codeword(uint64_t seq, int ch,
+                              std::shared_ptr<std::vector<uint8_t>> codeword);
+
+     public:
+      multichannel_decoder_impl(int n_channels, int threshold, bool rs_decode, bool descramble, bool deinterleave, int n_interleave, bool dual_basis, int n_threads, bool nrzm, uint64_t asm_, uint64_t asm_mask, int rs_e, int virtual_fill, bool check_fecf, bool drop_fecf_errors);
+      ~multichannel_decoder_impl();
+
+      uint64_t num_frames_received(int channel) const;
+      uint64_t num_frames_decoded(int channel) const;
+      uint64_t num_false_locks(int channel) const;
+      uint64_t num_fecf_errors(int channel) const;
+
+      bool stop();
+
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_MULTICHANNEL_DECODER_IMPL_H */
@@ -0,0 +1,233 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+#include <gnuradio/io_signature.h>
+#include "packet_extractor_impl.h"
+
+namespace gr {
+  namespace ccsds {
+
+    packet_extractor::sptr
+    packet_extractor::make(const std::vector<int> &apids, bool fecf)
+    {
+      return gnuradio::get_initial_sptr
+        (new packet_extractor_impl(apids, fecf));
+    }
+
+    packet_extractor_impl::packet_extractor_impl(const std::vector<int> &apids, bool fecf)
+      : gr::block("packet_extractor",
+              gr::io_signature::make(0, 0, 0),
+              gr::io_signature::make(0, 0, 0)),
+        d_fecf(fecf),
+        d_num_packets_dropped(0),
+        d_num_frames_dropped(0)
+    {
+      for (int i=0; i<MAX_VCIDS; i++) {
+          d_vcs[i].seen = false;
+          d_vcs[i].last_count = 0;
+          d_vcs[i].in_packet = false;
+          d_vcs[i].header_len = 0;
+          d_vcs[i].packet = pmt::PMT_NIL;
+          d_vcs[i].packet_len = 0;
+          d_vcs[i].filled = 0;
+      }
+
+      // the port of each apid is looked up by the apid
+      const pmt::pmt_t out = pmt::mp("out");
+      message_port_register_out(out);
+      for (int i=0; i<SPACE_PACKET_NUM_APIDS; i++) {
+          d_ports[i] = out;
+          d_num_packets[i] = 0;
+      }
+      for (size_t i=0; i<apids.size(); i++) {
+          const int apid = apids[i];
+          if (apid < 0 || apid >= SPACE_PACKET_NUM_APIDS) {
+              throw std::runtime_error("apids must be between 0 and 2047");
+          }
+          if (d_ports[apid] != out) {
+              throw std::runtime_error("apid " + std::to_string(apid) + " is given twice");
+          }
+          d_ports[apid] = pmt::mp("apid" + std::to_string(i));
+          message_port_register_out(d_ports[apid]);
+      }
+
+      message_port_register_in(pmt::mp("in"));
+      set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->handle_msg(msg); });
+    }
+
+    packet_extractor_impl::~packet_extractor_impl()
+    {
+    }
+
+    uint64_t packet_extractor_impl::num_packets(int apid) const
+    {
+        return (apid >= 0 && apid < SPACE_PACKET_NUM_APIDS) ? d_num_packets[apid] : 0;
+    }
+
+    void packet_extractor_impl::publish_packet(uint16_t apid, pmt::pmt_t packet)
+    {
+        d_num_packets[apid]++;
+        message_port_pub(d_ports[apid], pmt::cons(pmt::PMT_NIL, packet));
+    }
+
+    void packet_extractor_impl::drop_packet(vc_context &vc)
+    {
+        vc.in_packet = false;
+        vc.packet = pmt::PMT_NIL;
+        d_num_packets_dropped++;
+    }
+
+    size_t packet_extractor_impl::fill_packet(vc_context &vc, const uint8_t *data, size_t len)
+    {
+        size_t used = 0;
+        if (vc.header_len < SPACE_PACKET_HEADER_LEN) {
+            used = std::min(len, SPACE_PACKET_HEADER_LEN - vc.header_len);
+            memcpy(&vc.header[vc.header_len], data, used);
+            vc.header_len += used;
+            if (vc.header_len < SPACE_PACKET_HEADER_LEN) return used;
+
+            // the header gives the length, so the pdu vector is made once
+            // and the rest of the packet is copied into it. idle packets
+            // are only counted off.
+            vc.packet_len = space_packet_len(vc.header);
+            vc.filled = SPACE_PACKET_HEADER_LEN;
+            if (space_packet_apid(vc.header) != SPACE_PACKET_IDLE_APID) {
+                vc.packet = pmt::make_u8vector(vc.packet_len, 0);
+                size_t n = 0;
+                memcpy(pmt::u8vector_writable_elements(vc.packet, n), vc.header, SPACE_PACKET_HEADER_LEN);
+            }
+        }
+
+        const size_t take = std::min(len - used, vc.packet_len - vc.filled);
+        if (vc.packet != pmt::PMT_NIL) {
+            size_t n = 0;
+            memcpy(pmt::u8vector_writable_elements(vc.packet, n) + vc.filled, &data[used], take);
+        }
+        vc.filled += take;
+        used += take;
+
+        if (vc.filled == vc.packet_len) {
+            if (vc.packet != pmt::PMT_NIL) publish_packet(space_packet_apid(vc.header), vc.packet);
+            vc.in_packet = false;
+            vc.packet = pmt::PMT_NIL;
+        }
+        return used;
+    }
+
+    void packet_extractor_impl::handle_msg(pmt::pmt_t msg)
+    {
+        if (!pmt::is_pair(msg)) {
+            throw std::runtime_error("received a malformed pdu message");
+        }
+
+        size_t len = 0;
+        const uint8_t *frame = (const uint8_t *) pmt::uniform_vector_elements(pmt::cdr(msg), len);
+        frame_header fh;
+        if (!parse_frame_header(frame, len, fh)) {
+            d_num_frames_dropped++;
+            return;
+        }
+
+        // find the data field and its first header pointer
+        size_t start, trailer = d_fecf ? FECF_LEN : 0;
+        uint16_t fhp;
+        if (fh.version == TM_VERSION) {
+            if (frame[4] & 0x40) {
+                // synchronous data, not packets
+                d_num_frames_dropped++;
+                return;
+            }
+            start = TM_PRIMARY_HEADER_LEN;
+            if ((frame[4] & 0x80) && len > start) start += (frame[start] & 0x3f) + 1;
+            if (frame[1] & 0x01) trailer += TM_OCF_LEN;
+            fhp = ((frame[4] & 0x07) << 8) | frame[5];
+        } else {
+            start = AOS_PRIMARY_HEADER_LEN + AOS_MPDU_HEADER_LEN;
+            fhp = len >= start ? ((frame[6] & 0x07) << 8) | frame[7] : 0;
+        }
+        if (len < start + trailer) {
+            d_num_frames_dropped++;
+            return;
+        }
+        const uint8_t *data = &frame[start];
+        const size_t n = len - start - trailer;
+
+        vc_context &vc = d_vcs[fh.vcid];
+        if (vc.seen && fh.vc_count != (vc.last_count + 1) % fh.vc_count_mod) {
+            // frames are missing, so the packet being put together is not
+            // whole. start again at the next first header pointer.
+            if (vc.in_packet) drop_packet(vc);
+        }
+        vc.seen = true;
+        vc.last_count = fh.vc_count;
+
+        if (fhp == TM_FHP_IDLE) return;
+        if (fhp != TM_FHP_NO_PACKET && fhp >= n) {
+            if (vc.in_packet) drop_packet(vc);
+            d_num_frames_dropped++;
+            return;
+        }
+
+        if (vc.in_packet) {
+            // the data up to the first header pointer finishes the packet
+            // from the previous frames
+            const size_t avail = fhp == TM_FHP_NO_PACKET ? n : fhp;
+            fill_packet(vc, data, avail);
+            if (fhp == TM_FHP_NO_PACKET) return;
+            if (vc.in_packet) drop_packet(vc);
+        } else if (fhp == TM_FHP_NO_PACKET) {
+            // the middle of a packet whose start was missed
+            return;
+        }
+
+        size_t pos = fhp;
+        while (pos < n) {
+            const size_t left = n - pos;
+            if (left >= SPACE_PACKET_HEADER_LEN) {
+                const size_t plen = space_packet_len(&data[pos]);
+                if (plen <= left) {
+                    // a packet inside the frame is copied once, into its pdu
+                    const uint16_t apid = space_packet_apid(&data[pos]);
+                    if (apid != SPACE_PACKET_IDLE_APID) {
+                        publish_packet(apid, pmt::init_u8vector(plen, &data[pos]));
+                    }
+                    pos += plen;
+                    continue;
+                }
+            }
+
+            // the packet goes on in the next frame
+            vc.in_packet = true;
+            vc.header_len = 0;
+            vc.packet = pmt::PMT_NIL;
+            fill_packet(vc, &data[pos], left);
+            break;
+        }
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
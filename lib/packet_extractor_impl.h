@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_PACKET_EXTRACTOR_IMPL_H
+#define INCLUDED_CCSDS_PACKET_EXTRACTOR_IMPL_H
+
+#include <gnuradio/ccsds/packet_extractor.h>
+#include "ccsds.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class packet_extractor_impl : public packet_extractor
+    {
+     private:
+         // a packet being put together on a virtual channel. its header
+         // is gathered first, then the rest goes straight into the
+         // vector that is published.
+         struct vc_context {
+             bool seen;
+             uint32_t last_count;
+             bool in_packet;
+             uint8_t header[SPACE_PACKET_HEADER_LEN];
+             size_t header_len;
+             pmt::pmt_t packet;
+             size_t packet_len;
+             size_t filled;
+         };
+
+         const bool d_fecf;
+         vc_context d_vcs[MAX_VCIDS];
+         pmt::pmt_t d_ports[SPACE_PACKET_NUM_APIDS]; // indexed by apid
+         uint64_t d_num_packets[SPACE_PACKET_NUM_APIDS];
+         uint64_t d_num_packets_dropped;
+         uint64_t d_num_frames_dropped;
+
+         void handle_msg(pmt::pmt_t msg);
+         size_t fill_packet(vc_context &vc, const uint8_t *data, size_t len);
+         void drop_packet(vc_context &vc);
+         void publish_packet(uint16_t apid, pmt::pmt_t packet);
+
+     public:
+      packet_extractor_impl(const std::vector<int> &apids, bool fecf);
+      ~packet_extractor_impl();
+
+      uint64_t num_packets(int apid) const;
+      uint64_t num_packets_dropped() const { return d_num_packets_dropped; }
+      uint64_t num_frames_dropped() const { return d_num_frames_dropped; }
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_PACKET_EXTRACTOR_IMPL_H */
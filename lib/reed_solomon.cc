@@ -23,6 +23,8 @@
 #include <stdint.h>
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdexcept>
 
 extern "C" {
 #include "fec-3.0.1/fec.h"
@@ -38,22 +40,109 @@ extern unsigned char Tal1tab[];
 namespace gr {
     namespace ccsds {
 
-        reed_solomon::reed_solomon() {}
-        reed_solomon::~reed_solomon() {}
+        reed_solomon::reed_solomon(int e, int virtual_fill)
+          : d_e(e), d_pad(virtual_fill), d_codec(NULL)
+        {
+            if (e != 8 && e != 16) {
+                throw std::runtime_error("rs error correction capability must be 8 or 16");
+            }
+            if (virtual_fill < 0 || virtual_fill >= RS_NN - 2*e) {
+                throw std::runtime_error("virtual fill must leave at least one data symbol");
+            }
+            // E=16 uses the faster fixed (255,223) codec. the generator
+            // roots are alpha^(11*j) for j = 128-E .. 127+E.
+            if (e != RS_E) {
+                d_codec = init_rs_char(RS_BITS_PER_SYM, RS_GFPOLY, 128 - e, RS_APRIM, 2*e, virtual_fill);
+                if (d_codec == NULL) {
+                    throw std::runtime_error("could not set up the rs codec");
+                }
+            }
+        }
+        reed_solomon::~reed_solomon() {
+            if (d_codec) free_rs_char(d_codec);
+        }
 
         void reed_solomon::encode(uint8_t *data, bool use_dual_basis) {
-            if (use_dual_basis) {
-                encode_rs_ccsds(data, &data[RS_DATA_LEN],0);
-            } else {
-                encode_rs_8(data, &data[RS_DATA_LEN], 0);
+            encode(data, &data[data_len()], use_dual_basis);
+        }
+        void reed_solomon::encode(const uint8_t *data, uint8_t *parity, bool use_dual_basis) {
+            // the fec encoders only read the data
+            if (!d_codec) {
+                if (use_dual_basis) {
+                    encode_rs_ccsds((uint8_t *)data, parity, d_pad);
+                } else {
+                    encode_rs_8((uint8_t *)data, parity, d_pad);
+                }
+                return;
+            }
+
+            if (!use_dual_basis) {
+                encode_rs_char(d_codec, (uint8_t *)data, parity);
+                return;
             }
+            uint8_t cdata[RS_NN];
+            for (int i=0; i<data_len(); i++) cdata[i] = Tal1tab[data[i]];
+            encode_rs_char(d_codec, cdata, parity);
+            for (int i=0; i<parity_len(); i++) parity[i] = Taltab[parity[i]];
         }
         int16_t reed_solomon::decode(uint8_t *data, bool use_dual_basis) {
-            if (use_dual_basis) {
-                return decode_rs_ccsds(data, 0, 0, 0);
-            } else {
-                return decode_rs_8(data, 0, 0, 0);
+            if (!d_codec) {
+                if (use_dual_basis) {
+                    return decode_rs_ccsds(data, 0, 0, d_pad);
+                } else {
+                    return decode_rs_8(data, 0, 0, d_pad);
+                }
+            }
+
+            if (!use_dual_basis) {
+                return decode_rs_char(d_codec, data, 0, 0);
+            }
+            uint8_t cdata[RS_NN];
+            for (int i=0; i<block_len(); i++) cdata[i] = Tal1tab[data[i]];
+            const int n = decode_rs_char(d_codec, cdata, 0, 0);
+            if (n > 0) {
+                for (int i=0; i<block_len(); i++) data[i] = Taltab[cdata[i]];
+            }
+            return n;
+        }
+
+        int reed_solomon::decode_codeword(const uint8_t *codeword, uint8_t *payload,
+                                          int n_interleave, bool deinterleave,
+                                          bool descramble, bool rs_decode,
+                                          bool use_dual_basis, int &nerrors) {
+            // the scrambler is applied while gathering each block so that a
+            // false lock only costs the first block
+            const int block = block_len();
+            const int data = data_len();
+            uint8_t rs_block[RS_NN];
+            int ndecoded = 0;
+            nerrors = 0;
+            for (int i=0; i<n_interleave; i++) {
+                for (int j=0; j<block; j++) {
+                    const int k = deinterleave ? i+(j*n_interleave) : i*block + j;
+                    rs_block[j] = codeword[k];
+                    if (descramble) rs_block[j] ^= SCRAMBLER_POLY[k%SCRAMBLER_POLY_LEN];
+                }
+                if (rs_decode) {
+                    const int16_t n = decode(rs_block, use_dual_basis);
+                    if (n == -1) {
+                        if (i == 0) return -1;
+                    } else {
+                        nerrors += n;
+                        ndecoded++;
+                    }
+                } else {
+                    ndecoded++;
+                }
+                if (deinterleave) {
+                    for (int j=0; j<data; j++) {
+                        payload[i+(j*n_interleave)] = rs_block[j];
+                    }
+                } else {
+                    memcpy(&payload[i*data], rs_block, data);
+                }
             }
+            return ndecoded;
         }
 
     }
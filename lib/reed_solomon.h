@@ -29,14 +29,47 @@
 namespace gr {
     namespace ccsds {
 
+        /*
+         * CCSDS Reed-Solomon code correcting e symbol errors per block, 8
+         * or 16. The first virtual_fill symbols of every block are zero
+         * and are not sent, which shortens the block to block_len().
+         */
         class CCSDS_API reed_solomon {
             private:
+                int d_e;
+                int d_pad;
+                void *d_codec;  // libfec codec for e other than 16
+
+                reed_solomon(const reed_solomon &);
+                reed_solomon &operator=(const reed_solomon &);
+
             public:
-                reed_solomon();
+                reed_solomon(int e=16, int virtual_fill=0);
                 ~reed_solomon();
 
+                int e() const { return d_e; }
+                int virtual_fill() const { return d_pad; }
+                int parity_len() const { return 2*d_e; }
+                int block_len() const { return 255 - d_pad; }
+                int data_len() const { return block_len() - parity_len(); }
+
                 void encode(uint8_t *data, bool use_dual_basis);
+                // encode data_len() bytes of data into parity_len() bytes
+                // of parity stored elsewhere
+                void encode(const uint8_t *data, uint8_t *parity, bool use_dual_basis);
                 int16_t decode(uint8_t *data, bool use_dual_basis);
+
+                /*
+                 * deinterleave and descramble the n_interleave rs blocks of a
+                 * codeword and decode them into payload. returns the number
+                 * of blocks that could be corrected, or -1 if the first block
+                 * could not, in which case the rest are not tried. nerrors
+                 * gets the number of corrected symbols.
+                 */
+                int decode_codeword(const uint8_t *codeword, uint8_t *payload,
+                                    int n_interleave, bool deinterleave,
+                                    bool descramble, bool rs_decode,
+                                    bool use_dual_basis, int &nerrors);
         };
 
     }
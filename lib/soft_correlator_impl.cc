@@ -0,0 +1,228 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include <algorithm>
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include "soft_correlator_impl.h"
+
+// weight of one symbol in the running estimates
+#define SOFT_CORR_ALPHA (1.0f / 4096)
+// the threshold is never below this many rms of the correlation off the asm
+#define SOFT_CORR_SIDELOBE_FACTOR 2.5f
+
+namespace gr {
+  namespace ccsds {
+
+    soft_correlator::sptr
+    soft_correlator::make(size_t itemsize, const uint64_t asm_, const int asm_len,
+                          const float threshold, const size_t frame_len)
+    {
+      return gnuradio::get_initial_sptr
+        (new soft_correlator_impl(itemsize, asm_, asm_len, threshold, frame_len));
+    }
+
+    soft_correlator_impl::soft_correlator_impl(size_t itemsize, const uint64_t asm_, const int asm_len,
+                                               const float threshold, const size_t frame_len)
+      : gr::sync_block("soft_correlator",
+              gr::io_signature::make(1, 1, itemsize),
+              gr::io_signature::make(0, 0, 0)),
+      d_itemsize(itemsize), d_asm_len(asm_len),
+      d_threshold(threshold), d_frame_len(frame_len * 8),
+      d_frame_buffer_len(0), d_state(SEARCH), d_inverted(false),
+      d_correlation(0.0f), d_frame_count(0),
+      d_m2(0.0f), d_m4(0.0f), d_sidelobe(0.0f)
+    {
+        if (itemsize != sizeof(float) && itemsize != sizeof(int8_t)) {
+            throw std::runtime_error("itemsize must be sizeof(float) or sizeof(int8_t)");
+        }
+        if (asm_len < 1 || asm_len > 64) {
+            throw std::runtime_error("asm_len must be between 1 and 64");
+        }
+        if (threshold <= 0.0f || threshold > 1.0f) {
+            throw std::runtime_error("threshold must be above 0 and at most 1");
+        }
+
+        // the first bit of the asm is the msb of its asm_len bits
+        for (int i=0; i<asm_len; i++) {
+            d_pattern.push_back((asm_ >> (asm_len - 1 - i)) & 0x01 ? 1.0f : -1.0f);
+        }
+        d_frame_buffer.resize(d_frame_len * itemsize);
+
+        // the correlation window ends at the newest symbol
+        set_history(asm_len);
+        // room to look for the peak after a window over the threshold
+        set_min_noutput_items(asm_len);
+        message_port_register_out(pmt::mp("out"));
+    }
+
+    soft_correlator_impl::~soft_correlator_impl() {
+    }
+
+    float soft_correlator_impl::correlate(const float *in, int pos) const {
+        float corr = 0.0f;
+        volk_32f_x2_dot_prod_32f(&corr, &in[pos], d_pattern.data(), d_asm_len);
+        return corr;
+    }
+
+    void soft_correlator_impl::add_symbol(float x) {
+        const float x2 = x * x;
+        d_m2 += SOFT_CORR_ALPHA * (x2 - d_m2);
+        d_m4 += SOFT_CORR_ALPHA * (x2 * x2 - d_m4);
+    }
+
+    float soft_correlator_impl::amplitude2() const {
+        // for symbols +-a in gaussian noise, 3 m2^2 - m4 = 2 a^4
+        const float a4 = 0.5f * (3.0f * d_m2 * d_m2 - d_m4);
+        return a4 > 0.0f ? sqrtf(a4) : 0.0f;
+    }
+
+    float soft_correlator_impl::snr() const {
+        const float a2 = amplitude2();
+        const float noise = d_m2 - a2;
+        return noise > 0.0f ? a2 / noise : 0.0f;
+    }
+
+    float soft_correlator_impl::threshold2() const {
+        // threshold times the expected correlation of the asm, asm_len
+        // times the signal amplitude, and clear of the sidelobes
+        const float peak = d_threshold * d_asm_len;
+        return std::max(peak * peak * amplitude2(),
+                        SOFT_CORR_SIDELOBE_FACTOR * SOFT_CORR_SIDELOBE_FACTOR * d_sidelobe);
+    }
+
+    int
+    soft_correlator_impl::work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+        const uint8_t *raw = (const uint8_t *) input_items[0];
+        const size_t nin = noutput_items + d_asm_len - 1;
+
+        const float *in;
+        if (d_itemsize == sizeof(float)) {
+            in = (const float *) raw;
+        } else {
+            if (d_conv.size() < nin) d_conv.resize(nin);
+            volk_8i_s32f_convert_32f(d_conv.data(), (const int8_t *) raw, 1.0f, nin);
+            in = d_conv.data();
+        }
+
+        // symbol i of this call is in[i + asm_len - 1], the ones before it
+        // are history. the window starting at in[i] is compared to the asm.
+        if (d_m2 == 0.0f) {
+            // start the estimates from the first symbols
+            for (int i=0; i<noutput_items; i++) {
+                const float x2 = in[i + d_asm_len - 1] * in[i + d_asm_len - 1];
+                d_m2 += x2 / noutput_items;
+                d_m4 += x2 * x2 / noutput_items;
+            }
+            d_sidelobe = d_asm_len * d_m2;
+        }
+
+        int count = 0;
+        while (count < noutput_items) {
+            switch (d_state) {
+            case SEARCH: {
+                const float corr = correlate(in, count);
+                if (corr * corr < threshold2()) {
+                    d_sidelobe += SOFT_CORR_ALPHA * (corr * corr - d_sidelobe);
+                    add_symbol(in[count + d_asm_len - 1]);
+                    count++;
+                    break;
+                }
+
+                // with noise a window that only partly covers the asm can
+                // cross first, so lock on the strongest of the next asm_len
+                if (count + d_asm_len - 1 >= noutput_items) return count;
+                int best = count;
+                float best_corr = corr;
+                for (int k=1; k<d_asm_len; k++) {
+                    const float c = correlate(in, count + k);
+                    if (fabsf(c) > fabsf(best_corr)) {
+                        best = count + k;
+                        best_corr = c;
+                    }
+                }
+                for (; count<=best; count++) add_symbol(in[count + d_asm_len - 1]);
+
+                const float perfect = d_asm_len * sqrtf(amplitude2());
+                d_inverted = best_corr < 0.0f;
+                d_correlation = perfect > 0.0f ? fabsf(best_corr) / perfect : 0.0f;
+                d_frame_buffer_len = 0;
+                d_state = LOCK;
+                break;
+            }
+            case LOCK: {
+                // the frame body is copied as is, without slicing
+                const size_t n = std::min(d_frame_len - d_frame_buffer_len,
+                                          (size_t)(noutput_items - count));
+                memcpy(&d_frame_buffer[d_frame_buffer_len * d_itemsize],
+                       &raw[(count + d_asm_len - 1) * d_itemsize], n * d_itemsize);
+                for (size_t i=0; i<n; i++) add_symbol(in[count + d_asm_len - 1 + i]);
+                d_frame_buffer_len += n;
+                count += n;
+                if (d_frame_buffer_len == d_frame_len) {
+                    publish_msg();
+                    d_frame_count++;
+                    d_state = SEARCH;
+                }
+                break;
+            }
+            }
+        }
+        return noutput_items;
+    }
+
+    void soft_correlator_impl::publish_msg() {
+        pmt::pmt_t meta = pmt::make_dict();
+        meta = dict_add(meta, pmt::intern("frame_count"),
+                        pmt::from_uint64(d_frame_count));
+        meta = dict_add(meta, pmt::intern("correlation"),
+                        pmt::from_double(d_correlation));
+        meta = dict_add(meta, pmt::intern("inverted"),
+                        pmt::from_bool(d_inverted));
+
+        pmt::pmt_t data;
+        if (d_itemsize == sizeof(float)) {
+            float *syms = (float *) d_frame_buffer.data();
+            if (d_inverted) {
+                for (size_t i=0; i<d_frame_len; i++) syms[i] = -syms[i];
+            }
+            data = pmt::init_f32vector(d_frame_len, syms);
+        } else {
+            int8_t *syms = (int8_t *) d_frame_buffer.data();
+            if (d_inverted) {
+                for (size_t i=0; i<d_frame_len; i++) {
+                    syms[i] = syms[i] == -128 ? 127 : -syms[i];
+                }
+            }
+            data = pmt::init_s8vector(d_frame_len, syms);
+        }
+        message_port_pub(pmt::mp("out"), pmt::cons(meta, data));
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,77 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_SOFT_CORRELATOR_IMPL_H
+#define INCLUDED_CCSDS_SOFT_CORRELATOR_IMPL_H
+
+#include <gnuradio/ccsds/soft_correlator.h>
+#include <vector>
+
+namespace gr {
+  namespace ccsds {
+
+    class soft_correlator_impl : public soft_correlator {
+      private:
+        enum corr_state_t { SEARCH, LOCK };
+
+        const size_t d_itemsize;
+        const int d_asm_len;
+        const float d_threshold;
+        const size_t d_frame_len;   // in symbols
+
+        std::vector<float> d_pattern;  // asm mapped to +-1
+        std::vector<float> d_conv;     // int8 input converted to float
+        std::vector<uint8_t> d_frame_buffer;
+        size_t d_frame_buffer_len;     // in symbols
+
+        corr_state_t d_state;
+        bool d_inverted;
+        float d_correlation;
+        uint64_t d_frame_count;
+
+        // running means of x^2 and x^4 of the input symbols, and of the
+        // squared correlation at positions without a sync word
+        float d_m2;
+        float d_m4;
+        float d_sidelobe;
+
+        float correlate(const float *in, int pos) const;
+        void add_symbol(float x);
+        float amplitude2() const;
+        float threshold2() const;
+        void publish_msg();
+
+      public:
+        soft_correlator_impl(size_t itemsize, const uint64_t asm_, const int asm_len,
+                             const float threshold, const size_t frame_len);
+        ~soft_correlator_impl();
+
+        int work(int noutput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+
+        uint64_t frame_count() const { return d_frame_count; }
+        float snr() const;
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_SOFT_CORRELATOR_IMPL_H */
@@ -0,0 +1,89 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_SPSC_RING_H
+#define INCLUDED_SPSC_RING_H
+
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+
+namespace gr {
+    namespace ccsds {
+
+        /*
+         * Fixed capacity queue between exactly one producer thread and one
+         * consumer thread, without locks. Items are written and read in
+         * place: the producer fills write_slot() and calls push(), the
+         * consumer reads read_slot() and calls pop() when done with it.
+         *
+         * The capacity is rounded up to a power of two.
+         */
+        template <typename T>
+        class spsc_ring {
+            private:
+                std::vector<T> d_slots;
+                size_t d_mask;
+                // written by the producer and consumer respectively, kept
+                // on separate cache lines
+                alignas(64) std::atomic<size_t> d_head;
+                alignas(64) std::atomic<size_t> d_tail;
+
+            public:
+                spsc_ring(size_t capacity) : d_head(0), d_tail(0) {
+                    size_t n = 1;
+                    while (n < capacity) n <<= 1;
+                    d_slots.resize(n);
+                    d_mask = n - 1;
+                }
+
+                size_t capacity() const { return d_mask + 1; }
+
+                // number of items in the queue, exact only on the
+                // producer or consumer thread
+                size_t size() const {
+                    return d_head.load(std::memory_order_acquire) - d_tail.load(std::memory_order_acquire);
+                }
+
+                // producer side, nullptr if the queue is full
+                T *write_slot() {
+                    const size_t head = d_head.load(std::memory_order_relaxed);
+                    if (head - d_tail.load(std::memory_order_acquire) == capacity()) return nullptr;
+                    return &d_slots[head & d_mask];
+                }
+                void push() {
+                    d_head.store(d_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                }
+
+                // consumer side, nullptr if the queue is empty
+                T *read_slot() {
+                    const size_t tail = d_tail.load(std::memory_order_relaxed);
+                    if (tail == d_head.load(std::memory_order_acquire)) return nullptr;
+                    return &d_slots[tail & d_mask];
+                }
+                void pop() {
+                    d_tail.store(d_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                }
+        };
+
+    }
+}
+
+#endif /* INCLUDED_SPSC_RING_H */
@@ -0,0 +1,268 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "turbo.h"
+#include "ccsds.h"
+
+#include <string.h>
+#include <stdexcept>
+#include <algorithm>
+
+// unreachable state metric
+#define TURBO_NEG -1.0e30f
+// scaling of the extrinsic information passed between the component decoders
+#define TURBO_EXT_SCALE 0.75f
+
+namespace gr {
+    namespace ccsds {
+
+        static const int TURBO_PRIMES[8] = { 31, 37, 43, 47, 53, 59, 61, 67 };
+
+        /*
+         * transmitted symbols of one trellis step as (component << 2) |
+         * output, where output 0 is the systematic symbol. rate 1/2 sends
+         * 1a and 1b on alternating steps.
+         */
+        static const uint8_t TURBO_SYMBOLS_2[2][2] = { { 0x00, 0x01 }, { 0x00, 0x05 } };
+        static const uint8_t TURBO_SYMBOLS_3[3] = { 0x00, 0x01, 0x05 };
+        static const uint8_t TURBO_SYMBOLS_4[4] = { 0x00, 0x02, 0x03, 0x05 };
+        static const uint8_t TURBO_SYMBOLS_6[6] = { 0x00, 0x01, 0x02, 0x03, 0x05, 0x07 };
+
+        static inline uint8_t parity(uint32_t x) {
+            return __builtin_parity(x);
+        }
+
+        bool turbo::valid_info_len(int info_len)
+        {
+            return info_len == 1784 || info_len == 3568 || info_len == 7136 || info_len == 8920;
+        }
+
+        bool turbo::valid_rate(int rate)
+        {
+            return rate == 2 || rate == 3 || rate == 4 || rate == 6;
+        }
+
+        std::shared_ptr<const std::vector<int>> turbo::permutation(int info_len)
+        {
+            if (!valid_info_len(info_len)) {
+                throw std::runtime_error("unsupported turbo information block length");
+            }
+
+            const int k1 = 8;
+            const int k2 = info_len / k1;
+            std::shared_ptr<std::vector<int>> perm = std::make_shared<std::vector<int>>(info_len);
+            for (int s=1; s<=info_len; s++) {
+                const int m = (s - 1) % 2;
+                const int i = (s - 1) / (2 * k2);
+                const int j = (s - 1) / 2 - i * k2;
+                const int t = (19 * i + 1) % (k1 / 2);
+                const int q = t % 8 + 1;
+                const int c = (TURBO_PRIMES[q - 1] * j + 21 * m) % k2;
+                (*perm)[s - 1] = 2 * (t + c * (k1 / 2) + 1) - m - 1;
+            }
+            return perm;
+        }
+
+        turbo::turbo(int info_len, int rate, std::shared_ptr<const std::vector<int>> perm)
+            : d_info_len(info_len), d_rate(rate), d_nsteps(info_len + TURBO_TAIL)
+        {
+            if (!valid_info_len(info_len)) {
+                throw std::runtime_error("unsupported turbo information block length");
+            }
+            if (!valid_rate(rate)) {
+                throw std::runtime_error("unsupported turbo code rate");
+            }
+            if (perm && (int)perm->size() != info_len) {
+                throw std::runtime_error("turbo permutation does not match the block length");
+            }
+
+            d_perm_table = perm ? perm : permutation(info_len);
+            d_perm = d_perm_table->data();
+
+            // the state holds the last four register bits with the newest
+            // bit in the msb. the register bit w is the input bit plus the
+            // feedback, and state s moves to (w << 3) | (s >> 1).
+            for (uint32_t s=0; s<TURBO_NSTATES; s++) {
+                for (uint32_t w=0; w<2; w++) {
+                    const uint32_t reg = (w << 4) | s;
+                    const uint8_t u = w ^ parity(s & TURBO_POLY_0);
+                    d_code[s][w] = u
+                        | (parity(reg & TURBO_POLY_1) << 1)
+                        | (parity(reg & TURBO_POLY_2) << 2)
+                        | (parity(reg & TURBO_POLY_3) << 3);
+                }
+            }
+
+            for (int c=0; c<2; c++) {
+                d_sys[c].resize(d_nsteps);
+                for (int p=0; p<3; p++) d_par[c][p].resize(d_nsteps);
+                d_ext[c].resize(info_len);
+                d_bits[c].resize(info_len);
+            }
+            d_apr.assign(d_nsteps, 0.0f);
+            d_llr.resize(info_len);
+            d_alpha.resize((d_nsteps + 1) * TURBO_NSTATES);
+        }
+
+        turbo::~turbo() {}
+
+        static inline void branch_metrics(float *bm, float x0, float x1, float x2, float x3)
+        {
+            // metric of every combination of input and G1-G3 bits
+            bm[0] = 0.0f;
+            bm[1] = x0;
+            for (int i=0; i<2; i++) bm[2 + i] = bm[i] + x1;
+            for (int i=0; i<4; i++) bm[4 + i] = bm[i] + x2;
+            for (int i=0; i<8; i++) bm[8 + i] = bm[i] + x3;
+        }
+
+        static inline void normalize(float *m)
+        {
+            float max = m[0];
+            for (int s=1; s<TURBO_NSTATES; s++) max = std::max(max, m[s]);
+            for (int s=0; s<TURBO_NSTATES; s++) m[s] -= max;
+        }
+
+        void turbo::siso(int c)
+        {
+            const float *sys = d_sys[c].data();
+            const float *apr = d_apr.data();
+            const float *p1 = d_par[c][0].data();
+            const float *p2 = d_par[c][1].data();
+            const float *p3 = d_par[c][2].data();
+            float bm[16];
+
+            // forward recursion from state zero. states 2j and 2j+1 both
+            // move to states j and j+8, so each butterfly is two compares.
+            float *alpha = d_alpha.data();
+            for (int s=0; s<TURBO_NSTATES; s++) alpha[s] = s ? TURBO_NEG : 0.0f;
+            for (int t=0; t<d_nsteps; t++) {
+                branch_metrics(bm, sys[t] + apr[t], p1[t], p2[t], p3[t]);
+                const float *a = &alpha[t * TURBO_NSTATES];
+                float *n = &alpha[(t + 1) * TURBO_NSTATES];
+                for (int j=0; j<TURBO_NSTATES/2; j++) {
+                    for (int w=0; w<2; w++) {
+                        const float m0 = a[2*j] + bm[d_code[2*j][w]];
+                        const float m1 = a[2*j + 1] + bm[d_code[2*j + 1][w]];
+                        n[j + 8*w] = std::max(m0, m1);
+                    }
+                }
+                normalize(n);
+            }
+
+            // backward recursion into the terminated state zero, combined
+            // with the a posteriori llrs of the information bits
+            float beta[2][TURBO_NSTATES];
+            float *b = beta[0];
+            float *nb = beta[1];
+            for (int s=0; s<TURBO_NSTATES; s++) b[s] = s ? TURBO_NEG : 0.0f;
+            for (int t=d_nsteps; t-- > 0; ) {
+                branch_metrics(bm, sys[t] + apr[t], p1[t], p2[t], p3[t]);
+                const float *a = &alpha[t * TURBO_NSTATES];
+                float l0 = TURBO_NEG;
+                float l1 = TURBO_NEG;
+                for (int s=0; s<TURBO_NSTATES; s++) {
+                    const uint8_t c0 = d_code[s][0];
+                    const uint8_t c1 = d_code[s][1];
+                    const float m0 = bm[c0] + b[s >> 1];
+                    const float m1 = bm[c1] + b[(s >> 1) | 8];
+                    nb[s] = std::max(m0, m1);
+
+                    // the input bit of a branch is its code bit 0
+                    const float u0 = a[s] + m0;
+                    const float u1 = a[s] + m1;
+                    if (c0 & 0x01) l1 = std::max(l1, u0); else l0 = std::max(l0, u0);
+                    if (c1 & 0x01) l1 = std::max(l1, u1); else l0 = std::max(l0, u1);
+                }
+                normalize(nb);
+                std::swap(b, nb);
+
+                if (t < d_info_len) {
+                    const float llr = l1 - l0;
+                    d_ext[c][t] = TURBO_EXT_SCALE * (llr - sys[t] - apr[t]);
+                    if (c == 1) d_llr[t] = llr;
+                }
+            }
+        }
+
+        bool turbo::decode(const float *syms, uint8_t *info, int max_iterations,
+                           bool check_crc, int &iterations)
+        {
+            // demultiplex the codeblock into the two component codes
+            for (int c=0; c<2; c++) {
+                for (int p=0; p<3; p++) {
+                    std::fill(d_par[c][p].begin(), d_par[c][p].end(), 0.0f);
+                }
+            }
+            for (int t=0; t<d_nsteps; t++) {
+                const uint8_t *map;
+                switch (d_rate) {
+                    case 2: map = TURBO_SYMBOLS_2[t & 0x01]; break;
+                    case 3: map = TURBO_SYMBOLS_3; break;
+                    case 4: map = TURBO_SYMBOLS_4; break;
+                    default: map = TURBO_SYMBOLS_6; break;
+                }
+                for (int i=0; i<d_rate; i++) {
+                    const int comp = map[i] >> 2;
+                    const int out = map[i] & 0x03;
+                    if (out == 0) {
+                        d_sys[0][t] = syms[t * d_rate + i];
+                    } else {
+                        d_par[comp][out - 1][t] = syms[t * d_rate + i];
+                    }
+                }
+            }
+            // the systematic symbols of encoder b are the interleaved ones of
+            // encoder a, its termination bits are not sent
+            for (int t=0; t<d_info_len; t++) d_sys[1][t] = d_sys[0][d_perm[t]];
+            std::fill(d_sys[1].begin() + d_info_len, d_sys[1].end(), 0.0f);
+            std::fill(d_ext[1].begin(), d_ext[1].end(), 0.0f);
+
+            const int nbytes = d_info_len / 8;
+            iterations = 0;
+            while (iterations < max_iterations) {
+                for (int t=0; t<d_info_len; t++) d_apr[d_perm[t]] = d_ext[1][t];
+                siso(0);
+                for (int t=0; t<d_info_len; t++) d_apr[t] = d_ext[0][d_perm[t]];
+                siso(1);
+                iterations++;
+
+                uint8_t *bits = d_bits[iterations & 0x01].data();
+                const uint8_t *last = d_bits[(iterations + 1) & 0x01].data();
+                for (int t=0; t<d_info_len; t++) bits[d_perm[t]] = d_llr[t] > 0.0f;
+
+                memset(info, 0, nbytes);
+                for (int i=0; i<d_info_len; i++) {
+                    info[i >> 3] |= bits[i] << (7 - (i & 0x07));
+                }
+
+                if (check_crc && crc16(info, nbytes) == 0) {
+                    return true;
+                }
+                if (iterations > 1 && memcmp(bits, last, d_info_len) == 0) {
+                    // further iterations will not change the decisions
+                    return !check_crc;
+                }
+            }
+            return false;
+        }
+
+    }
+}
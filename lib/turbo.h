@@ -0,0 +1,106 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_TURBO_H
+#define INCLUDED_TURBO_H
+
+#include <gnuradio/ccsds/api.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <memory>
+
+// turbo code constants
+#define TURBO_NSTATES 16
+#define TURBO_TAIL 4    // trellis termination steps per component code
+#define TURBO_POLY_0 0x13 // G0 = 10011 (feedback)
+#define TURBO_POLY_1 0x1b // G1 = 11011
+#define TURBO_POLY_2 0x15 // G2 = 10101
+#define TURBO_POLY_3 0x1f // G3 = 11111
+
+namespace gr {
+    namespace ccsds {
+
+        /*
+         * Max-log-MAP decoder for the CCSDS turbo code (CCSDS 131.0-B
+         * section 6) with information blocks of 1784, 3568, 7136 or 8920
+         * bits and rates 1/2, 1/3, 1/4 or 1/6. Each instance keeps its own
+         * working buffers, so independent codeblocks can be decoded in
+         * parallel with one instance per thread.
+         *
+         * Soft symbols follow the GNU Radio convention where a positive
+         * value means a one bit.
+         */
+        class CCSDS_API turbo {
+            private:
+                const int d_info_len;
+                const int d_rate;             // inverse code rate
+                const int d_nsteps;           // info_len + TURBO_TAIL
+
+                // encoder b reads info bit d_perm[t] at step t. the table
+                // may be shared read-only between instances.
+                std::shared_ptr<const std::vector<int>> d_perm_table;
+                const int *d_perm;
+                uint8_t d_code[TURBO_NSTATES][2]; // branch outputs, bit 0 is the input, bits 1-3 are G1-G3
+
+                std::vector<float> d_sys[2];  // systematic symbols of each component code
+                std::vector<float> d_par[2][3]; // G1-G3 symbols, zero where punctured
+                std::vector<float> d_apr;     // a priori input of the current component
+                std::vector<float> d_ext[2];  // scaled extrinsic output of each component
+                std::vector<float> d_llr;     // a posteriori output of component b
+                std::vector<float> d_alpha;   // forward metrics of all steps
+                std::vector<uint8_t> d_bits[2]; // hard decisions of this and the last iteration
+
+                void siso(int c);
+
+            public:
+                /*
+                 * perm is the table from permutation(info_len), or null to
+                 * build one for this instance.
+                 */
+                turbo(int info_len, int rate,
+                      std::shared_ptr<const std::vector<int>> perm = nullptr);
+                ~turbo();
+
+                static bool valid_info_len(int info_len);
+                static bool valid_rate(int rate);
+
+                // interleaver permutation, CCSDS 131.0-B section 6.3
+                static std::shared_ptr<const std::vector<int>> permutation(int info_len);
+
+                int info_len() const { return d_info_len; }
+                int codeblock_len() const { return d_nsteps * d_rate; }
+
+                /*
+                 * decode codeblock_len() soft symbols into info_len()/8
+                 * packed bytes. stops once the hard decisions no longer
+                 * change or, with check_crc, once the trailing crc16 of the
+                 * information block is correct. returns true if the crc is
+                 * correct (with check_crc) or the decisions converged.
+                 */
+                bool decode(const float *syms, uint8_t *info, int max_iterations,
+                            bool check_crc, int &iterations);
+        };
+
+    }
+}
+
+#endif /* INCLUDED_TURBO_H */
@@ -0,0 +1,180 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <gnuradio/io_signature.h>
+#include "turbo_decoder_impl.h"
+#include "ccsds.h"
+
+namespace gr {
+  namespace ccsds {
+
+    turbo_decoder::sptr
+    turbo_decoder::make(int info_len, int rate, int max_iterations, bool check_crc, bool descramble, int n_threads)
+    {
+      return gnuradio::get_initial_sptr
+        (new turbo_decoder_impl(info_len, rate, max_iterations, check_crc, descramble, n_threads));
+    }
+
+    turbo_decoder_impl::turbo_decoder_impl(int info_len, int rate, int max_iterations, bool check_crc, bool descramble, int n_threads)
+      : gr::block("turbo_decoder",
+              gr::io_signature::make(0, 0, 0),
+              gr::io_signature::make(0, 0, 0)),
+        d_info_len(info_len),
+        d_rate(rate),
+        d_max_iterations(max_iterations),
+        d_check_crc(check_crc),
+        d_descramble(descramble),
+        d_num_frames_decoded(0),
+        d_num_frames_failed(0),
+        d_num_iterations(0),
+        d_next_seq(0),
+        d_next_pub(0),
+        d_pool(n_threads < 0 ? 1 : n_threads)
+    {
+      if (!turbo::valid_info_len(info_len)) {
+          throw std::runtime_error("info_len must be 1784, 3568, 7136 or 8920");
+      }
+      if (!turbo::valid_rate(rate)) {
+          throw std::runtime_error("rate must be 2, 3, 4 or 6");
+      }
+
+      // bound the number of codeblocks queued up behind the workers
+      d_max_pending = 2 * d_pool.num_threads();
+
+      // the permutation and decoder buffers are set up here rather than
+      // on the workers during the first decodes
+      d_perm = turbo::permutation(info_len);
+      for (unsigned i=0; i<d_pool.num_threads(); i++) {
+          d_free.emplace_back(new turbo(info_len, rate, d_perm));
+      }
+
+      message_port_register_out(pmt::mp("out"));
+      message_port_register_in(pmt::mp("in"));
+      set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->handle_msg(msg); });
+    }
+
+    turbo_decoder_impl::~turbo_decoder_impl()
+    {
+    }
+
+    float turbo_decoder_impl::average_iterations() const
+    {
+        const uint64_t nframes = d_num_frames_decoded + d_num_frames_failed;
+        return nframes ? (float)d_num_iterations / nframes : 0.0f;
+    }
+
+    bool turbo_decoder_impl::stop()
+    {
+        d_pool.wait_idle();
+        return true;
+    }
+
+    void turbo_decoder_impl::handle_msg(pmt::pmt_t msg)
+    {
+        if (!pmt::is_pair(msg)) {
+            throw std::runtime_error("received a malformed pdu message");
+        }
+
+        const pmt::pmt_t vec = pmt::cdr(msg);
+        const size_t codeblock_len = (d_info_len + TURBO_TAIL) * d_rate;
+        std::shared_ptr<std::vector<float>> syms = std::make_shared<std::vector<float>>(codeblock_len);
+        size_t len = 0;
+        if (pmt::is_f32vector(vec)) {
+            const float *in = pmt::f32vector_elements(vec, len);
+            if (len == codeblock_len) memcpy(syms->data(), in, codeblock_len * sizeof(float));
+        } else if (pmt::is_s8vector(vec)) {
+            const int8_t *in = pmt::s8vector_elements(vec, len);
+            if (len == codeblock_len) {
+                for (size_t i=0; i<codeblock_len; i++) (*syms)[i] = in[i];
+            }
+        } else {
+            printf("[ERROR] unsupported codeblock vector type\n");
+            return;
+        }
+        if (len != codeblock_len) {
+            printf("[ERROR] expected %i soft symbols, got %i\n", (int)codeblock_len, (int)len);
+            return;
+        }
+        if (d_descramble) {
+            for (size_t i=0; i<codeblock_len; i++) {
+                if (scrambler_bit(i)) (*syms)[i] = -(*syms)[i];
+            }
+        }
+
+        uint64_t seq;
+        {
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_cond.wait(lock, [this] { return d_next_seq - d_next_pub < d_max_pending; });
+            seq = d_next_seq++;
+        }
+        const pmt::pmt_t meta = pmt::car(msg);
+        d_pool.submit([this, seq, meta, syms] { decode_frame(seq, meta, syms); });
+    }
+
+    void turbo_decoder_impl::decode_frame(uint64_t seq, pmt::pmt_t meta,
+                                          std::shared_ptr<std::vector<float>> syms)
+    {
+        std::unique_ptr<turbo> dec;
+        {
+            std::lock_guard<std::mutex> lock(d_mutex);
+            if (!d_free.empty()) {
+                dec = std::move(d_free.back());
+                d_free.pop_back();
+            }
+        }
+        if (!dec) dec.reset(new turbo(d_info_len, d_rate, d_perm));
+
+        std::vector<uint8_t> info(d_info_len / 8);
+        int iterations = 0;
+        const bool success = dec->decode(syms->data(), info.data(), d_max_iterations,
+                                         d_check_crc, iterations);
+        d_num_iterations += iterations;
+
+        pmt::pmt_t pdu = pmt::PMT_NIL;
+        if (success) {
+            d_num_frames_decoded++;
+            if (!pmt::is_dict(meta)) meta = pmt::make_dict();
+            meta = pmt::dict_add(meta, pmt::intern("iterations"), pmt::from_long(iterations));
+            pdu = pmt::cons(meta, pmt::init_u8vector(info.size(), info.data()));
+        } else {
+            d_num_frames_failed++;
+        }
+
+        // publish in the order the codeblocks were received
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_free.push_back(std::move(dec));
+        d_done[seq] = pdu;
+        while (!d_done.empty() && d_done.begin()->first == d_next_pub) {
+            if (!pmt::eq(d_done.begin()->second, pmt::PMT_NIL)) {
+                message_port_pub(pmt::mp("out"), d_done.begin()->second);
+            }
+            d_done.erase(d_done.begin());
+            d_next_pub++;
+        }
+        d_cond.notify_all();
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_TURBO_DECODER_IMPL_H
+#define INCLUDED_CCSDS_TURBO_DECODER_IMPL_H
+
+#include <gnuradio/ccsds/turbo_decoder.h>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "turbo.h"
+#include "worker_pool.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class turbo_decoder_impl : public turbo_decoder
+    {
+     private:
+         const int d_info_len;
+         const int d_rate;
+         const int d_max_iterations;
+         const bool d_check_crc;
+         const bool d_descramble;
+
+         std::atomic<uint64_t> d_num_frames_decoded;
+         std::atomic<uint64_t> d_num_frames_failed;
+         std::atomic<uint64_t> d_num_iterations;
+
+         std::mutex d_mutex;
+         std::condition_variable d_cond;
+         // decoders that are not in use by a worker, one per pool thread,
+         // all sharing one interleaver permutation
+         std::shared_ptr<const std::vector<int>> d_perm;
+         std::vector<std::unique_ptr<turbo>> d_free;
+         // decoded frames waiting for the frames before them, nil if dropped
+         std::map<uint64_t, pmt::pmt_t> d_done;
+         uint64_t d_next_seq;
+         uint64_t d_next_pub;
+         uint64_t d_max_pending;
+
+         // destroyed first, so running decodes finish while the rest is alive
+         worker_pool d_pool;
+
+         void handle_msg(pmt::pmt_t msg);
+         void decode_frame(uint64_t seq, pmt::pmt_t meta,
+                           std::shared_ptr<std::vector<float>> syms);
+
+     public:
+      turbo_decoder_impl(int info_len, int rate, int max_iterations, bool check_crc, bool descramble, int n_threads);
+      ~turbo_decoder_impl();
+
+      uint64_t num_frames_decoded() const { return d_num_frames_decoded; }
+      uint64_t num_frames_failed() const { return d_num_frames_failed; }
+      float average_iterations() const;
+
+      bool stop();
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_TURBO_DECODER_IMPL_H */
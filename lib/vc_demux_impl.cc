@@ -0,0 +1,124 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string>
+#include <gnuradio/io_signature.h>
+#include "vc_demux_impl.h"
+
+namespace gr {
+  namespace ccsds {
+
+    vc_demux::sptr
+    vc_demux::make(const std::vector<int> &vcids, int scid)
+    {
+      return gnuradio::get_initial_sptr
+        (new vc_demux_impl(vcids, scid));
+    }
+
+    vc_demux_impl::vc_demux_impl(const std::vector<int> &vcids, int scid)
+      : gr::block("vc_demux",
+              gr::io_signature::make(0, 0, 0),
+              gr::io_signature::make(0, 0, 0)),
+        d_scid(scid),
+        d_num_frames_dropped(0)
+    {
+      if (vcids.empty()) {
+          throw std::runtime_error("vc_demux needs at least one virtual channel");
+      }
+      if (scid < -1 || scid > 1023) {
+          throw std::runtime_error("scid must be between 0 and 1023, or -1 for any");
+      }
+      for (int i=0; i<MAX_VCIDS; i++) {
+          d_vcs[i] = {pmt::PMT_NIL, false, 0, 0, 0, 0};
+      }
+
+      // the port of each virtual channel is looked up by its id
+      for (size_t i=0; i<vcids.size(); i++) {
+          const int vcid = vcids[i];
+          if (vcid < 0 || vcid >= MAX_VCIDS) {
+              throw std::runtime_error("vcids must be between 0 and 63");
+          }
+          if (d_vcs[vcid].port != pmt::PMT_NIL) {
+              throw std::runtime_error("vcid " + std::to_string(vcid) + " is given twice");
+          }
+          d_vcs[vcid].port = pmt::mp("out" + std::to_string(i));
+          message_port_register_out(d_vcs[vcid].port);
+      }
+
+      message_port_register_in(pmt::mp("in"));
+      set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->handle_msg(msg); });
+    }
+
+    vc_demux_impl::~vc_demux_impl()
+    {
+    }
+
+    uint64_t vc_demux_impl::num_frames(int vcid) const
+    {
+        return (vcid >= 0 && vcid < MAX_VCIDS) ? d_vcs[vcid].num_frames : 0;
+    }
+
+    uint64_t vc_demux_impl::num_gaps(int vcid) const
+    {
+        return (vcid >= 0 && vcid < MAX_VCIDS) ? d_vcs[vcid].num_gaps : 0;
+    }
+
+    uint64_t vc_demux_impl::num_lost_frames(int vcid) const
+    {
+        return (vcid >= 0 && vcid < MAX_VCIDS) ? d_vcs[vcid].num_lost : 0;
+    }
+
+    void vc_demux_impl::handle_msg(pmt::pmt_t msg)
+    {
+        if (!pmt::is_pair(msg)) {
+            throw std::runtime_error("received a malformed pdu message");
+        }
+
+        // the header is read in place and the pdu is passed on as it is
+        size_t len = 0;
+        const uint8_t *frame = (const uint8_t *) pmt::uniform_vector_elements(pmt::cdr(msg), len);
+        frame_header fh;
+        if (!parse_frame_header(frame, len, fh) ||
+            (d_scid >= 0 && fh.scid != d_scid) ||
+            d_vcs[fh.vcid].port == pmt::PMT_NIL) {
+            d_num_frames_dropped++;
+            return;
+        }
+
+        vc_state &vc = d_vcs[fh.vcid];
+        if (vc.seen && fh.vc_count != (vc.last_count + 1) % fh.vc_count_mod) {
+            const uint32_t lost = (fh.vc_count - vc.last_count - 1) & (fh.vc_count_mod - 1);
+            vc.num_gaps++;
+            vc.num_lost += lost;
+        }
+        vc.seen = true;
+        vc.last_count = fh.vc_count;
+        vc.num_frames++;
+
+        message_port_pub(vc.port, msg);
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
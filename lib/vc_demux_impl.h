@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_VC_DEMUX_IMPL_H
+#define INCLUDED_CCSDS_VC_DEMUX_IMPL_H
+
+#include <gnuradio/ccsds/vc_demux.h>
+#include "ccsds.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class vc_demux_impl : public vc_demux
+    {
+     private:
+         struct vc_state {
+             pmt::pmt_t port;     // PMT_NIL if the channel is not routed
+             bool seen;
+             uint32_t last_count;
+             uint64_t num_frames;
+             uint64_t num_gaps;
+             uint64_t num_lost;
+         };
+
+         const int d_scid;
+         vc_state d_vcs[MAX_VCIDS]; // indexed by virtual channel id
+         uint64_t d_num_frames_dropped;
+
+         void handle_msg(pmt::pmt_t msg);
+
+     public:
+      vc_demux_impl(const std::vector<int> &vcids, int scid);
+      ~vc_demux_impl();
+
+      uint64_t num_frames(int vcid) const;
+      uint64_t num_gaps(int vcid) const;
+      uint64_t num_lost_frames(int vcid) const;
+      uint64_t num_frames_dropped() const { return d_num_frames_dropped; }
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_VC_DEMUX_IMPL_H */
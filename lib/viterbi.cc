@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "viterbi.h"
+
+namespace gr {
+    namespace ccsds {
+
+        static inline uint8_t parity(uint32_t x) {
+            return __builtin_parity(x);
+        }
+
+        viterbi::viterbi(bool invert_g2) : d_invert_g2(invert_g2)
+        {
+            // the state holds the last six input bits with the newest bit in
+            // the lsb. a state s is entered from (s >> 1) and (s >> 1) | 32
+            // with input bit s & 1. store which of the four symbol pairs
+            // each of these two branches produces.
+            for (uint32_t s=0; s<CONV_NSTATES; s++) {
+                for (uint32_t p=0; p<2; p++) {
+                    uint32_t reg = (p << 6) | s;
+                    uint8_t sym_a = parity(reg & CONV_POLY_A);
+                    uint8_t sym_b = parity(reg & CONV_POLY_B) ^ (d_invert_g2 ? 1 : 0);
+                    d_branch[s][p] = (sym_a << 1) | sym_b;
+                }
+            }
+        }
+
+        viterbi::~viterbi() {}
+
+        void viterbi::decode(const float *syms, size_t nbits, size_t skip,
+                             size_t nout, uint8_t *out)
+        {
+            float metrics[2][CONV_NSTATES];
+            float *old_m = metrics[0];
+            float *new_m = metrics[1];
+
+            if (d_decisions.size() < nbits) d_decisions.resize(nbits);
+
+            // unknown starting state
+            for (int s=0; s<CONV_NSTATES; s++) old_m[s] = 0.0f;
+
+            for (size_t t=0; t<nbits; t++) {
+                const float a = syms[2*t];
+                const float b = syms[2*t+1];
+                // metric of each symbol pair, indexed by (sym_a << 1) | sym_b
+                const float bm[4] = { -a-b, -a+b, a-b, a+b };
+
+                uint64_t decisions = 0;
+                for (int s=0; s<CONV_NSTATES; s++) {
+                    const float m0 = old_m[s >> 1] + bm[d_branch[s][0]];
+                    const float m1 = old_m[(s >> 1) | 32] + bm[d_branch[s][1]];
+                    const bool d = m1 > m0;
+                    new_m[s] = d ? m1 : m0;
+                    decisions |= (uint64_t)d << s;
+                }
+                d_decisions[t] = decisions;
+
+                // keep the metrics small to not lose float precision
+                const float norm = new_m[0];
+                for (int s=0; s<CONV_NSTATES; s++) new_m[s] -= norm;
+
+                float *tmp = old_m;
+                old_m = new_m;
+                new_m = tmp;
+            }
+
+            // trace back from the best end state
+            uint32_t state = 0;
+            for (int s=1; s<CONV_NSTATES; s++) {
+                if (old_m[s] > old_m[state]) state = s;
+            }
+            for (size_t t=nbits; t-- > 0; ) {
+                if (t >= skip && t < skip + nout) {
+                    out[t - skip] = state & 0x01;
+                }
+                const uint32_t d = (d_decisions[t] >> state) & 0x01;
+                state = (state >> 1) | (d << 5);
+            }
+        }
+
+    }
+}
@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_VITERBI_H
+#define INCLUDED_VITERBI_H
+
+#include <gnuradio/ccsds/api.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// convolutional code (k=7, r=1/2) constants
+#define CONV_K 7
+#define CONV_NSTATES 64
+#define CONV_POLY_A 0x4f // G1 = 171 (octal), newest bit in the lsb
+#define CONV_POLY_B 0x6d // G2 = 133 (octal), newest bit in the lsb
+
+namespace gr {
+    namespace ccsds {
+
+        /*
+         * Soft decision viterbi decoder for the CCSDS rate 1/2 convolutional
+         * code. Each instance decodes one segment at a time, so independent
+         * segments can be decoded in parallel with one instance per segment.
+         *
+         * Soft symbols follow the GNU Radio convention where a positive
+         * value means a one bit.
+         */
+        class CCSDS_API viterbi {
+            private:
+                bool d_invert_g2;
+                uint8_t d_branch[CONV_NSTATES][2];
+                std::vector<uint64_t> d_decisions;
+
+            public:
+                viterbi(bool invert_g2=true);
+                ~viterbi();
+
+                /*
+                 * decode nbits bits from the 2*nbits symbols in syms, starting
+                 * from an unknown state and tracing back from the best end
+                 * state. only bits [skip, skip+nout) are written to out, one
+                 * bit per byte, so that the first and last bits can be used as
+                 * training and traceback margins.
+                 */
+                void decode(const float *syms, size_t nbits, size_t skip,
+                            size_t nout, uint8_t *out);
+        };
+
+    }
+}
+
+#endif /* INCLUDED_VITERBI_H */
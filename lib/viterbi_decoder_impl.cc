@@ -0,0 +1,107 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <gnuradio/io_signature.h>
+#include "viterbi_decoder_impl.h"
+
+namespace gr {
+  namespace ccsds {
+
+    viterbi_decoder::sptr
+    viterbi_decoder::make(int n_threads, int segment_len, int margin, bool invert_g2)
+    {
+      return gnuradio::get_initial_sptr
+        (new viterbi_decoder_impl(n_threads, segment_len, margin, invert_g2));
+    }
+
+    viterbi_decoder_impl::viterbi_decoder_impl(int n_threads, int segment_len, int margin, bool invert_g2)
+      : gr::block("viterbi_decoder",
+              gr::io_signature::make(1, 1, sizeof(float)),
+              gr::io_signature::make(1, 1, sizeof(uint8_t))),
+        d_segment_len(segment_len),
+        d_margin(margin),
+        d_invert_g2(invert_g2),
+        d_num_segments(0),
+        d_pool(n_threads < 0 ? 1 : n_threads)
+    {
+      if (segment_len <= 0 || margin < 0) {
+          throw std::runtime_error("viterbi_decoder: invalid segment length or margin");
+      }
+
+      // the history holds the training symbols of the first segment
+      set_history(2*d_margin + 1);
+      set_output_multiple(d_segment_len);
+      set_relative_rate(1, 2);
+    }
+
+    viterbi_decoder_impl::~viterbi_decoder_impl()
+    {
+    }
+
+    void
+    viterbi_decoder_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      // two symbols per bit, plus the traceback margin after the last bit
+      ninput_items_required[0] = 2*(noutput_items + d_margin);
+    }
+
+    int
+    viterbi_decoder_impl::general_work(int noutput_items,
+        gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      const float *in = (const float *) input_items[0];
+      uint8_t *out = (uint8_t *) output_items[0];
+
+      int nbits = std::min(noutput_items, ninput_items[0]/2 - d_margin);
+      nbits -= nbits % d_segment_len;
+      if (nbits <= 0) {
+          consume_each(0);
+          return 0;
+      }
+
+      const size_t nsegments = nbits / d_segment_len;
+      if (d_viterbi.size() < nsegments) {
+          d_viterbi.resize(nsegments, viterbi(d_invert_g2));
+      }
+
+      // in[0] is the first training symbol of the first segment, and
+      // segment i starts its training 2*i*segment_len symbols later
+      d_pool.parallel_for(nsegments, [&](size_t i) {
+          d_viterbi[i].decode(&in[2*i*d_segment_len],
+                              d_margin + d_segment_len + d_margin,
+                              d_margin,
+                              d_segment_len,
+                              &out[i*d_segment_len]);
+      });
+      d_num_segments += nsegments;
+
+      consume_each(2*nbits);
+      return nbits;
+    }
+
+  } /* namespace ccsds */
+} /* namespace gr */
@@ -0,0 +1,62 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_CCSDS_VITERBI_DECODER_IMPL_H
+#define INCLUDED_CCSDS_VITERBI_DECODER_IMPL_H
+
+#include <gnuradio/ccsds/viterbi_decoder.h>
+#include <vector>
+#include "viterbi.h"
+#include "worker_pool.h"
+
+namespace gr {
+  namespace ccsds {
+
+    class viterbi_decoder_impl : public viterbi_decoder
+    {
+     private:
+         const int d_segment_len;
+         const int d_margin;
+         const bool d_invert_g2;
+
+         uint64_t d_num_segments;
+
+         // one decoder per segment of a work call
+         std::vector<viterbi> d_viterbi;
+         worker_pool d_pool;
+
+     public:
+      viterbi_decoder_impl(int n_threads, int segment_len, int margin, bool invert_g2);
+      ~viterbi_decoder_impl();
+
+      uint64_t num_segments() const { return d_num_segments; }
+
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+    };
+
+  } // namespace ccsds
+} // namespace gr
+
+#endif /* INCLUDED_CCSDS_VITERBI_DECODER_IMPL_H */
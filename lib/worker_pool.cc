@@ -0,0 +1,145 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "worker_pool.h"
+
+namespace gr {
+    namespace ccsds {
+
+        worker_pool::worker_pool(unsigned n_threads)
+            : d_active(0), d_generation(0), d_stop(false)
+        {
+            if (n_threads == 0) {
+                n_threads = std::thread::hardware_concurrency();
+            }
+            // the thread calling parallel_for() takes part in the work
+            for (unsigned i=1; i<n_threads; i++) {
+                d_threads.emplace_back(&worker_pool::worker_loop, this);
+            }
+        }
+
+        worker_pool::~worker_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_stop = true;
+            }
+            d_work_cond.notify_all();
+            for (size_t i=0; i<d_threads.size(); i++) {
+                d_threads[i].join();
+            }
+        }
+
+        void worker_pool::parallel_for(size_t n, const std::function<void(size_t)> &fn)
+        {
+            if (d_threads.empty() || n <= 1) {
+                for (size_t i=0; i<n; i++) fn(i);
+                return;
+            }
+
+            // every call gets its own job so that a worker still leaving
+            // the previous one can never pick up an index of this one
+            std::shared_ptr<job> j = std::make_shared<job>();
+            j->fn = &fn;
+            j->size = n;
+            j->next = 0;
+            j->pending = n;
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_job = j;
+                d_generation++;
+            }
+            d_work_cond.notify_all();
+
+            run_job(*j);
+
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_done_cond.wait(lock, [&j] { return j->pending == 0; });
+            d_job.reset();
+        }
+
+        void worker_pool::submit(std::function<void()> fn)
+        {
+            if (d_threads.empty()) {
+                fn();
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(d_mutex);
+                d_tasks.push_back(std::move(fn));
+            }
+            d_work_cond.notify_one();
+        }
+
+        void worker_pool::wait_idle()
+        {
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_idle_cond.wait(lock, [this] { return d_tasks.empty() && d_active == 0; });
+        }
+
+        void worker_pool::run_job(job &j)
+        {
+            size_t i;
+            while ((i = j.next.fetch_add(1)) < j.size) {
+                (*j.fn)(i);
+                if (j.pending.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(d_mutex);
+                    d_done_cond.notify_all();
+                }
+            }
+        }
+
+        void worker_pool::worker_loop()
+        {
+            uint64_t seen = 0;
+            while (true) {
+                std::shared_ptr<job> j;
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(d_mutex);
+                    d_work_cond.wait(lock, [this, seen] {
+                        return d_stop || (d_job && d_generation != seen) || !d_tasks.empty();
+                    });
+                    if (d_stop) return;
+                    // parallel_for() has a caller waiting on it, so it goes first
+                    if (d_job && d_generation != seen) {
+                        seen = d_generation;
+                        j = d_job;
+                    } else {
+                        task = std::move(d_tasks.front());
+                        d_tasks.pop_front();
+                        d_active++;
+                    }
+                }
+                if (j) {
+                    run_job(*j);
+                    continue;
+                }
+
+                task();
+                std::lock_guard<std::mutex> lock(d_mutex);
+                if (--d_active == 0 && d_tasks.empty()) {
+                    d_idle_cond.notify_all();
+                }
+            }
+        }
+
+    }
+}
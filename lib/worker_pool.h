@@ -0,0 +1,94 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 André Løfaldli.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_WORKER_POOL_H
+#define INCLUDED_WORKER_POOL_H
+
+#include <gnuradio/ccsds/api.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gr {
+    namespace ccsds {
+
+        /*
+         * A fixed set of worker threads used by blocks that split their
+         * work into independent chunks (segments, codeblocks, ...).
+         *
+         * n_threads counts the calling thread as well, so a pool of one
+         * thread runs everything inline and n_threads=0 uses one thread
+         * per hardware core.
+         *
+         * Besides parallel_for(), single tasks can be queued with submit()
+         * for blocks that must not wait for their work to complete.
+         */
+        class CCSDS_API worker_pool {
+            private:
+                struct job {
+                    const std::function<void(size_t)> *fn;
+                    size_t size;
+                    std::atomic<size_t> next;
+                    std::atomic<size_t> pending;
+                };
+
+                std::vector<std::thread> d_threads;
+                std::mutex d_mutex;
+                std::condition_variable d_work_cond;
+                std::condition_variable d_done_cond;
+                std::condition_variable d_idle_cond;
+                std::shared_ptr<job> d_job;
+                std::deque<std::function<void()>> d_tasks;
+                size_t d_active;
+                uint64_t d_generation;
+                bool d_stop;
+
+                void worker_loop();
+                void run_job(job &j);
+
+            public:
+                worker_pool(unsigned n_threads);
+                ~worker_pool();
+
+                unsigned num_threads() const { return d_threads.size() + 1; }
+
+                // calls fn(0) .. fn(n-1) spread over the pool and returns
+                // once all calls have completed
+                void parallel_for(size_t n, const std::function<void(size_t)> &fn);
+
+                // queues fn to run on one of the worker threads, or runs it
+                // right away when the pool has no worker threads. tasks that
+                // have not started when the pool is destroyed are dropped.
+                void submit(std::function<void()> fn);
+
+                // waits until all submitted tasks have completed
+                void wait_idle();
+        };
+
+    }
+}
+
+#endif /* INCLUDED_WORKER_POOL_H */
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ccsds_decoder.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(05c854ff374f104d8802cc3afddb3527)                     */
+/* BINDTOOL_HEADER_FILE_HASH(af25d12245eda36ab0507185e388e0a7)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -45,6 +45,16 @@ void bind_ccsds_decoder(py::module& m)
            py::arg("printing") = false,
            py::arg("n_interleave") = 5,
            py::arg("dual_basis") = true,
+           py::arg("slip_window") = 0,
+           py::arg("queue_depth") = 0,
+           py::arg("drop_on_overflow") = false,
+           py::arg("nrzm") = false,
+           py::arg("asm_") = 449838109,
+           py::arg("asm_mask") = 4294967295U,
+           py::arg("rs_e") = 16,
+           py::arg("virtual_fill") = 0,
+           py::arg("check_fecf") = false,
+           py::arg("drop_fecf_errors") = false,
            D(ccsds_decoder,make)
         )
         
@@ -69,6 +79,84 @@ void bind_ccsds_decoder(py::module& m)
             D(ccsds_decoder,num_subframes_decoded)
         )
 
+
+        
+        .def("num_bit_slips",&ccsds_decoder::num_bit_slips,       
+            D(ccsds_decoder,num_bit_slips)
+        )
+
+
+        
+        .def("num_false_locks",&ccsds_decoder::num_false_locks,       
+            D(ccsds_decoder,num_false_locks)
+        )
+
+
+        
+        .def("num_frames_dropped",&ccsds_decoder::num_frames_dropped,       
+            D(ccsds_decoder,num_frames_dropped)
+        )
+
+
+        
+        .def("queue_depth",&ccsds_decoder::queue_depth,       
+            D(ccsds_decoder,queue_depth)
+        )
+
+
+        
+        .def("max_queue_depth",&ccsds_decoder::max_queue_depth,       
+            D(ccsds_decoder,max_queue_depth)
+        )
+
+
+        
+        .def("set_threshold",&ccsds_decoder::set_threshold,       
+            py::arg("threshold"),
+            D(ccsds_decoder,set_threshold)
+        )
+
+
+        
+        .def("set_rs_decode",&ccsds_decoder::set_rs_decode,       
+            py::arg("rs_decode"),
+            D(ccsds_decoder,set_rs_decode)
+        )
+
+
+        
+        .def("set_deinterleave",&ccsds_decoder::set_deinterleave,       
+            py::arg("deinterleave"),
+            D(ccsds_decoder,set_deinterleave)
+        )
+
+
+        
+        .def("set_descramble",&ccsds_decoder::set_descramble,       
+            py::arg("descramble"),
+            D(ccsds_decoder,set_descramble)
+        )
+
+
+        
+        .def("set_n_interleave",&ccsds_decoder::set_n_interleave,       
+            py::arg("n_interleave"),
+            D(ccsds_decoder,set_n_interleave)
+        )
+
+
+        
+        .def("set_dual_basis",&ccsds_decoder::set_dual_basis,       
+            py::arg("dual_basis"),
+            D(ccsds_decoder,set_dual_basis)
+        )
+
+
+        
+        .def("num_fecf_errors",&ccsds_decoder::num_fecf_errors,       
+            D(ccsds_decoder,num_fecf_errors)
+        )
+
         ;
 
 
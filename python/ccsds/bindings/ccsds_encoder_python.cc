@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(ccsds_encoder.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(9d7df0e4206f192e5e24ce5f4311fac0)                     */
+/* BINDTOOL_HEADER_FILE_HASH(d4c7210121cde936f67fd055dc25887f)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -46,6 +46,17 @@ void bind_ccsds_encoder(py::module& m)
            py::arg("verbose") = false,
            py::arg("n_interleave") = 5,
            py::arg("dual_basis") = true,
+           py::arg("continuous") = false,
+           py::arg("frame_rate") = 0,
+           py::arg("segment") = false,
+           py::arg("scid") = 0,
+           py::arg("vcid") = 0,
+           py::arg("flush_timeout") = 0.1,
+           py::arg("output_format") = ::gr::ccsds::output_format_t::OUTPUT_PACKED,
+           py::arg("nrzm") = false,
+           py::arg("rs_e") = 16,
+           py::arg("virtual_fill") = 0,
+           py::arg("fecf") = false,
            D(ccsds_encoder,make)
         )
         
@@ -58,6 +69,47 @@ void bind_ccsds_encoder(py::module& m)
             D(ccsds_encoder,num_frames)
         )
 
+
+        
+        .def("set_rs_encode",&ccsds_encoder::set_rs_encode,       
+            py::arg("rs_encode"),
+            D(ccsds_encoder,set_rs_encode)
+        )
+
+
+        
+        .def("set_interleave",&ccsds_encoder::set_interleave,       
+            py::arg("interleave"),
+            D(ccsds_encoder,set_interleave)
+        )
+
+
+        
+        .def("set_scramble",&ccsds_encoder::set_scramble,       
+            py::arg("scramble"),
+            D(ccsds_encoder,set_scramble)
+        )
+
+
+        
+        .def("set_n_interleave",&ccsds_encoder::set_n_interleave,       
+            py::arg("n_interleave"),
+            D(ccsds_encoder,set_n_interleave)
+        )
+
+
+        
+        .def("set_dual_basis",&ccsds_encoder::set_dual_basis,       
+            py::arg("dual_basis"),
+            D(ccsds_encoder,set_dual_basis)
+        )
+
+
+        
+        .def("num_idle_frames",&ccsds_encoder::num_idle_frames,       
+            D(ccsds_encoder,num_idle_frames)
+        )
+
         ;
 
 
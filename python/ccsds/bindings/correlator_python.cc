@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(correlator.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(6263c7daf8f3852a252f66cc8f1b3fd0)                     */
+/* BINDTOOL_HEADER_FILE_HASH(bbb2d667ab9b370138a525fc1a340494)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -36,12 +36,25 @@ void bind_correlator(py::module& m)
     py::class_<correlator, gr::sync_block, gr::block, gr::basic_block,
         std::shared_ptr<correlator>>(m, "correlator", D(correlator))
 
-        .def(py::init(&correlator::make),
+        .def(py::init((correlator::sptr(*)(const uint64_t, const uint64_t, const uint8_t, const size_t, const int, const bool)) &correlator::make),
            py::arg("asm_") = 449838109,
            py::arg("asm_mask") = 4294967295U,
            py::arg("threshold") = 2,
            py::arg("frame_len") = 223,
-           D(correlator,make)
+           py::arg("slip_window") = 0,
+           py::arg("nrzm") = false,
+           D(correlator,make,0)
+        )
+
+
+        .def(py::init((correlator::sptr(*)(const std::vector<uint64_t> &, const std::vector<uint64_t> &, const std::vector<uint8_t> &, const std::vector<size_t> &, const int, const bool)) &correlator::make),
+           py::arg("asms"),
+           py::arg("asm_masks"),
+           py::arg("thresholds"),
+           py::arg("frame_lens"),
+           py::arg("slip_window") = 0,
+           py::arg("nrzm") = false,
+           D(correlator,make,1)
         )
         
 
@@ -53,11 +66,18 @@ void bind_correlator(py::module& m)
             D(correlator,frame_count)
         )
 
+
+        
+        .def("num_bit_slips",&correlator::num_bit_slips,       
+            D(correlator,num_bit_slips)
+        )
+
         ;
 
     py::enum_<::gr::ccsds::state_t>(m,"state_t")
         .value("SEARCH", ::gr::ccsds::state_t::SEARCH) // 0
         .value("LOCK", ::gr::ccsds::state_t::LOCK) // 1
+        .value("RESYNC", ::gr::ccsds::state_t::RESYNC) // 2
         .export_values()
     ;
 
@@ -36,4 +36,40 @@
 
  static const char *__doc_gr_ccsds_ccsds_decoder_num_subframes_decoded = R"doc()doc";
 
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_num_bit_slips = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_num_false_locks = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_num_frames_dropped = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_queue_depth = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_max_queue_depth = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_threshold = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_rs_decode = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_deinterleave = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_descramble = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_n_interleave = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_set_dual_basis = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_decoder_num_fecf_errors = R"doc()doc";
   
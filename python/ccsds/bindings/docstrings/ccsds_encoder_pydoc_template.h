@@ -30,4 +30,22 @@
 
  static const char *__doc_gr_ccsds_ccsds_encoder_num_frames = R"doc()doc";
 
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_set_rs_encode = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_set_interleave = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_set_scramble = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_set_n_interleave = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_set_dual_basis = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_ccsds_encoder_num_idle_frames = R"doc()doc";
   
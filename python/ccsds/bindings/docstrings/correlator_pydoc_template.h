@@ -25,9 +25,15 @@
  static const char *__doc_gr_ccsds_correlator_correlator_1 = R"doc()doc";
 
 
- static const char *__doc_gr_ccsds_correlator_make = R"doc()doc";
+ static const char *__doc_gr_ccsds_correlator_make_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_correlator_make_1 = R"doc()doc";
 
 
  static const char *__doc_gr_ccsds_correlator_frame_count = R"doc()doc";
 
+
+
+ static const char *__doc_gr_ccsds_correlator_num_bit_slips = R"doc()doc";
   
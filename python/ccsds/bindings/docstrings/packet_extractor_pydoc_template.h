@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,ccsds, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_ccsds_packet_extractor = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_packet_extractor_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_packet_extractor_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_make = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_num_packets = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_num_packets_dropped = R"doc()doc";
+
+
+ static const char *__doc_gr_ccsds_packet_extractor_num_frames_dropped = R"doc()doc";
+
+  
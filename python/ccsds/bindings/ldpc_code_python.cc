@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(ldpc_code.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(3b973242bd0024d36a8258090c2b0181)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/ldpc_code.h>
+// pydoc.h is automatically generated in the build directory
+#include <ldpc_code_pydoc.h>
+
+void bind_ldpc_code(py::module& m)
+{
+
+
+    py::enum_<::gr::ccsds::ldpc_code_t>(m,"ldpc_code_t")
+        .value("LDPC_C2", ::gr::ccsds::ldpc_code_t::LDPC_C2) // 0
+        .export_values()
+    ;
+
+    py::implicitly_convertible<int, ::gr::ccsds::ldpc_code_t>();
+
+
+
+}
+
+
+
+
+
+
+
+
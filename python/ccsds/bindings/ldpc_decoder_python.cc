@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(ldpc_decoder.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(56ad7950b74ca6e6f88ed871a46de92d)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/ldpc_decoder.h>
+// pydoc.h is automatically generated in the build directory
+#include <ldpc_decoder_pydoc.h>
+
+void bind_ldpc_decoder(py::module& m)
+{
+
+    using ldpc_decoder    = ::gr::ccsds::ldpc_decoder;
+
+
+    py::class_<ldpc_decoder, gr::block, gr::basic_block,
+        std::shared_ptr<ldpc_decoder>>(m, "ldpc_decoder", D(ldpc_decoder))
+
+        .def(py::init(&ldpc_decoder::make),
+           py::arg("code") = ::gr::ccsds::ldpc_code_t::LDPC_C2,
+           py::arg("max_iterations") = 50,
+           py::arg("descramble") = true,
+           D(ldpc_decoder,make)
+        )
+        
+
+
+
+
+        
+        .def("num_frames_decoded",&ldpc_decoder::num_frames_decoded,       
+            D(ldpc_decoder,num_frames_decoded)
+        )
+
+
+        
+        .def("num_frames_failed",&ldpc_decoder::num_frames_failed,       
+            D(ldpc_decoder,num_frames_failed)
+        )
+
+
+        
+        .def("average_iterations",&ldpc_decoder::average_iterations,       
+            D(ldpc_decoder,average_iterations)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(multichannel_decoder.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(7ba44af0d47c676841d0cdf5cebb552a)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/multichannel_decoder.h>
+// pydoc.h is automatically generated in the build directory
+#include <multichannel_decoder_pydoc.h>
+
+void bind_multichannel_decoder(py::module& m)
+{
+
+    using multichannel_decoder    = ::gr::ccsds::multichannel_decoder;
+
+
+    py::class_<multichannel_decoder, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<multichannel_decoder>>(m, "multichannel_decoder", D(multichannel_decoder))
+
+        .def(py::init(&multichannel_decoder::make),
+           py::arg("n_channels") = 2,
+           py::arg("threshold") = 0,
+           py::arg("rs_decode") = true,
+           py::arg("descramble") = true,
+           py::arg("deinterleave") = true,
+           py::arg("n_interleave") = 5,
+           py::arg("dual_basis") = true,
+           py::arg("n_threads") = 0,
+           py::arg("nrzm") = false,
+           py::arg("asm_") = 0x1acffc1d,
+           py::arg("asm_mask") = 0xffffffff,
+           py::arg("rs_e") = 16,
+           py::arg("virtual_fill") = 0,
+           py::arg("check_fecf") = false,
+           py::arg("drop_fecf_errors") = false,
+           D(multichannel_decoder,make)
+        )
+        
+
+
+
+
+        
+        .def("num_frames_received",&multichannel_decoder::num_frames_received,       
+            py::arg("channel"),
+            D(multichannel_decoder,num_frames_received)
+        )
+
+
+        
+        .def("num_frames_decoded",&multichannel_decoder::num_frames_decoded,       
+            py::arg("channel"),
+            D(multichannel_decoder,num_frames_decoded)
+        )
+
+
+        
+        .def("num_false_locks",&multichannel_decoder::num_false_locks,       
+            py::arg("channel"),
+            D(multichannel_decoder,num_false_locks)
+        )
+
+
+        
+        .def("num_fecf_errors",&multichannel_decoder::num_fecf_errors,       
+            py::arg("channel"),
+            D(multichannel_decoder,num_fecf_errors)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(output_format.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(088be396667e013cac3ddd5396886839)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/output_format.h>
+// pydoc.h is automatically generated in the build directory
+#include <output_format_pydoc.h>
+
+void bind_output_format(py::module& m)
+{
+
+
+    py::enum_<::gr::ccsds::output_format_t>(m,"output_format_t")
+        .value("OUTPUT_PACKED", ::gr::ccsds::output_format_t::OUTPUT_PACKED) // 0
+        .value("OUTPUT_UNPACKED", ::gr::ccsds::output_format_t::OUTPUT_UNPACKED) // 1
+        .value("OUTPUT_SOFT", ::gr::ccsds::output_format_t::OUTPUT_SOFT) // 2
+        .export_values()
+    ;
+
+    py::implicitly_convertible<int, ::gr::ccsds::output_format_t>();
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(packet_extractor.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(65f68f86f9d8b329a5f60cf819e2ab34)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/packet_extractor.h>
+// pydoc.h is automatically generated in the build directory
+#include <packet_extractor_pydoc.h>
+
+void bind_packet_extractor(py::module& m)
+{
+
+    using packet_extractor    = ::gr::ccsds::packet_extractor;
+
+
+    py::class_<packet_extractor, gr::block, gr::basic_block,
+        std::shared_ptr<packet_extractor>>(m, "packet_extractor", D(packet_extractor))
+
+        .def(py::init(&packet_extractor::make),
+           py::arg("apids") = std::vector<int>(),
+           py::arg("fecf") = false,
+           D(packet_extractor,make)
+        )
+        
+
+
+
+
+        
+        .def("num_packets",&packet_extractor::num_packets,       
+            py::arg("apid"),
+            D(packet_extractor,num_packets)
+        )
+
+
+        
+        .def("num_packets_dropped",&packet_extractor::num_packets_dropped,       
+            D(packet_extractor,num_packets_dropped)
+        )
+
+
+        
+        .def("num_frames_dropped",&packet_extractor::num_frames_dropped,       
+            D(packet_extractor,num_frames_dropped)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
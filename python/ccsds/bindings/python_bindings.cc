@@ -24,6 +24,16 @@ namespace py = pybind11;
 void bind_ccsds_decoder(py::module& m);
 void bind_ccsds_encoder(py::module& m);
 void bind_correlator(py::module& m);
+void bind_viterbi_decoder(py::module& m);
+void bind_ldpc_code(py::module& m);
+void bind_ldpc_decoder(py::module& m);
+void bind_ldpc_encoder(py::module& m);
+void bind_turbo_decoder(py::module& m);
+void bind_soft_correlator(py::module& m);
+void bind_multichannel_decoder(py::module& m);
+void bind_output_format(py::module& m);
+void bind_vc_demux(py::module& m);
+void bind_packet_extractor(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
 
 
@@ -52,8 +62,18 @@ PYBIND11_MODULE(ccsds_python, m)
     // Please do not delete
     /**************************************/
     // BINDING_FUNCTION_CALLS(
+    bind_output_format(m);
     bind_ccsds_decoder(m);
     bind_ccsds_encoder(m);
     bind_correlator(m);
+    bind_viterbi_decoder(m);
+    bind_ldpc_code(m);
+    bind_ldpc_decoder(m);
+    bind_ldpc_encoder(m);
+    bind_turbo_decoder(m);
+    bind_soft_correlator(m);
+    bind_multichannel_decoder(m);
+    bind_vc_demux(m);
+    bind_packet_extractor(m);
     // ) END BINDING_FUNCTION_CALLS
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(soft_correlator.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(6309f7398f576b40b2408297250d0226)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/soft_correlator.h>
+// pydoc.h is automatically generated in the build directory
+#include <soft_correlator_pydoc.h>
+
+void bind_soft_correlator(py::module& m)
+{
+
+    using soft_correlator    = ::gr::ccsds::soft_correlator;
+
+
+    py::class_<soft_correlator, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<soft_correlator>>(m, "soft_correlator", D(soft_correlator))
+
+        .def(py::init(&soft_correlator::make),
+           py::arg("itemsize") = sizeof(float),
+           py::arg("asm_") = 0x1acffc1d,
+           py::arg("asm_len") = 32,
+           py::arg("threshold") = 0.6,
+           py::arg("frame_len") = 223,
+           D(soft_correlator,make)
+        )
+        
+
+
+
+
+        
+        .def("frame_count",&soft_correlator::frame_count,       
+            D(soft_correlator,frame_count)
+        )
+
+
+        
+        .def("snr",&soft_correlator::snr,       
+            D(soft_correlator,snr)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(turbo_decoder.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(dcdca754b7c1c051c9117634c8985cd7)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/turbo_decoder.h>
+// pydoc.h is automatically generated in the build directory
+#include <turbo_decoder_pydoc.h>
+
+void bind_turbo_decoder(py::module& m)
+{
+
+    using turbo_decoder    = ::gr::ccsds::turbo_decoder;
+
+
+    py::class_<turbo_decoder, gr::block, gr::basic_block,
+        std::shared_ptr<turbo_decoder>>(m, "turbo_decoder", D(turbo_decoder))
+
+        .def(py::init(&turbo_decoder::make),
+           py::arg("info_len") = 1784,
+           py::arg("rate") = 2,
+           py::arg("max_iterations") = 10,
+           py::arg("check_crc") = false,
+           py::arg("descramble") = true,
+           py::arg("n_threads") = 1,
+           D(turbo_decoder,make)
+        )
+        
+
+
+
+
+        
+        .def("num_frames_decoded",&turbo_decoder::num_frames_decoded,       
+            D(turbo_decoder,num_frames_decoded)
+        )
+
+
+        
+        .def("num_frames_failed",&turbo_decoder::num_frames_failed,       
+            D(turbo_decoder,num_frames_failed)
+        )
+
+
+        
+        .def("average_iterations",&turbo_decoder::average_iterations,       
+            D(turbo_decoder,average_iterations)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(vc_demux.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(f43c98376cd0d56dd860a4fe6a16d146)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <gnuradio/ccsds/vc_demux.h>
+// pydoc.h is automatically generated in the build directory
+#include <vc_demux_pydoc.h>
+
+void bind_vc_demux(py::module& m)
+{
+
+    using vc_demux    = ::gr::ccsds::vc_demux;
+
+
+    py::class_<vc_demux, gr::block, gr::basic_block,
+        std::shared_ptr<vc_demux>>(m, "vc_demux", D(vc_demux))
+
+        .def(py::init(&vc_demux::make),
+           py::arg("vcids") = std::vector<int>(1, 0),
+           py::arg("scid") = -1,
+           D(vc_demux,make)
+        )
+        
+
+
+
+
+        
+        .def("num_frames",&vc_demux::num_frames,       
+            py::arg("vcid"),
+            D(vc_demux,num_frames)
+        )
+
+
+        
+        .def("num_gaps",&vc_demux::num_gaps,       
+            py::arg("vcid"),
+            D(vc_demux,num_gaps)
+        )
+
+
+        
+        .def("num_lost_frames",&vc_demux::num_lost_frames,       
+            py::arg("vcid"),
+            D(vc_demux,num_lost_frames)
+        )
+
+
+        
+        .def("num_frames_dropped",&vc_demux::num_frames_dropped,       
+            D(vc_demux,num_frames_dropped)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -19,10 +19,27 @@
 # Boston, MA 02110-1301, USA.
 #
 
+import time
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import ccsds_python as ccsds
 
+ASM_BITS = [(0x1acffc1d >> (31-i)) & 1 for i in range(32)]
+
+def frame_data (nframes, data_len=1115, seed=0):
+    return [[(seed + 7*f + x) % 256 for x in range(data_len)] for f in range(nframes)]
+
+def encode (frames, **kwargs):
+    # unpacked bits of the encoded frames, sync word included
+    src = blocks.vector_source_b(sum(frames, []))
+    enc = ccsds.ccsds_encoder(gr.sizeof_char, "", output_format=ccsds.OUTPUT_UNPACKED, **kwargs)
+    dst = blocks.vector_sink_b()
+    tb = gr.top_block()
+    tb.connect(src, enc, dst)
+    tb.run()
+    return list(dst.data())
+
 class qa_ccsds_decoder (gr_unittest.TestCase):
 
     def setUp (self):
@@ -31,10 +48,129 @@ class qa_ccsds_decoder (gr_unittest.TestCase):
     def tearDown (self):
         self.tb = None
 
-    def test_001_t (self):
-        # set up fg
-        self.tb.run ()
-        # check data
+    def setup_decoder (self, dec):
+        self.src = blocks.vector_source_b([])
+        self.dbg = blocks.message_debug()
+        self.tb.connect(self.src, dec)
+        self.tb.msg_connect(dec, "out", self.dbg, "store")
+
+    def run_bits (self, bits, nexpected):
+        # the frames are published from the message port, wait for them
+        # before stopping
+        self.src.set_data(bits)
+        self.tb.start()
+        timeout = time.time() + 5
+        while self.dbg.num_messages() < nexpected and time.time() < timeout:
+            time.sleep(0.01)
+        self.tb.stop()
+        self.tb.wait()
+
+    def received (self):
+        return [list(pmt.u8vector_elements(pmt.cdr(self.dbg.get_message(i))))
+                for i in range(self.dbg.num_messages())]
+
+    def test_001_false_sync (self):
+        # a sync word 300 bits before a real frame makes the decoder lock
+        # early. the real sync word is inside the failed codeword and the
+        # decoder goes back to it.
+        frames = frame_data(1)
+        bits = [0]*100 + ASM_BITS + [0]*300 + encode(frames)
+        dec = ccsds.ccsds_decoder()
+        self.setup_decoder(dec)
+        self.run_bits(bits, 1)
+
+        assert self.received() == frames
+        assert dec.num_frames_received() == 2
+        assert dec.num_false_locks() == 1
+
+    def test_002_slip (self):
+        # two extra bits before the third sync word are found in the slip
+        # window without a new search
+        frames = frame_data(3)
+        bits = encode(frames)
+        frame_bits = len(bits) // len(frames)
+        bits = bits[:2*frame_bits] + [1, 0] + bits[2*frame_bits:]
+        dec = ccsds.ccsds_decoder(slip_window=4)
+        self.setup_decoder(dec)
+        self.run_bits(bits, len(frames))
+
+        assert self.received() == frames
+        assert dec.num_bit_slips() == 1
+
+    def test_003_early_reject (self):
+        # the first rs block of the first frame is uncorrectable. the
+        # decoder gives up on it without decoding the other blocks and
+        # finds the next frame.
+        frames = frame_data(2)
+        bits = encode(frames)
+        for j in range(0, 1275, 5):
+            pattern = ((37*j + 11) & 0xff) | 1
+            for k in range(8):
+                bits[32 + 8*j + k] ^= (pattern >> (7-k)) & 1
+        dec = ccsds.ccsds_decoder()
+        self.setup_decoder(dec)
+        self.run_bits(bits, 1)
+
+        assert self.received() == frames[1:]
+        assert dec.num_frames_received() == 2
+        assert dec.num_false_locks() == 1
+        assert dec.num_subframes_decoded() == 5
+
+    def test_004_queue (self):
+        # frames decoded on the decode thread are published in order
+        frames = frame_data(6)
+        dec = ccsds.ccsds_decoder(queue_depth=2)
+        self.setup_decoder(dec)
+        self.run_bits(encode(frames), len(frames))
+
+        assert self.received() == frames
+        assert dec.num_frames_dropped() == 0
+        assert dec.max_queue_depth() <= 2
+
+    def test_005_config (self):
+        # a new interleaving depth from the config port applies to the
+        # frames that follow
+        frames5 = frame_data(2)
+        frames1 = frame_data(2, 223, seed=1)
+        dec = ccsds.ccsds_decoder()
+        self.setup_decoder(dec)
+        self.run_bits(encode(frames5), 2)
+
+        config = pmt.dict_add(pmt.make_dict(), pmt.intern("n_interleave"), pmt.from_long(1))
+        dec.to_basic_block()._post(pmt.intern("config"), config)
+        self.run_bits(encode(frames1, n_interleave=1), 4)
+
+        assert self.received() == frames5 + frames1
+
+    def test_006_nrzm (self):
+        # nrz-m input decodes at either polarity. inverted, the first bit
+        # of the first sync word is wrong, which the threshold allows.
+        frames = frame_data(3)
+        bits = encode(frames, nrzm=True)
+        for invert in (0, 1):
+            self.tb = gr.top_block()
+            dec = ccsds.ccsds_decoder(threshold=2, nrzm=True)
+            self.setup_decoder(dec)
+            self.run_bits([b ^ invert for b in bits], len(frames))
+
+            assert self.received() == frames
+
+    def test_007_asm64 (self):
+        # a 64-bit sync word in place of the 32-bit one
+        asm = 0x034776c7272895b0
+        asm_bits = [(asm >> (63-i)) & 1 for i in range(64)]
+        frames = frame_data(3)
+        encoded = encode(frames)
+        frame_bits = len(encoded) // len(frames)
+        bits = []
+        for f in range(len(frames)):
+            bits += asm_bits + encoded[f*frame_bits+32:(f+1)*frame_bits]
+        dec = ccsds.ccsds_decoder(threshold=6, asm_=asm, asm_mask=0xffffffffffffffff)
+        self.setup_decoder(dec)
+        self.run_bits(bits, len(frames))
+
+        assert self.received() == frames
+        assert dec.num_frames_received() == len(frames)
 
 
 if __name__ == '__main__':
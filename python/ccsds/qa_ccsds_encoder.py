@@ -24,6 +24,12 @@ from gnuradio import blocks
 import ccsds_python as ccsds
 import pmt, time
 
+def parse_tm_header (frame):
+    scid = ((frame[0] & 0x3f) << 4) | (frame[1] >> 4)
+    vcid = (frame[1] >> 1) & 0x07
+    fhp = ((frame[4] & 0x07) << 8) | frame[5]
+    return (scid, vcid, frame[2], frame[3], fhp)
+
 class qa_ccsds_encoder (gr_unittest.TestCase):
 
     def setUp (self):
@@ -57,5 +63,137 @@ class qa_ccsds_encoder (gr_unittest.TestCase):
 #        print pmt.cdr(msg)
 
 
+    def test_002_batch (self):
+        # without a length tag every 1115 bytes of the stream is a frame
+        src_data = [x%256 for x in range(3*1115)]
+        src = blocks.vector_source_b(src_data)
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "")
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, enc, dst)
+        self.tb.run()
+
+        frames = dst.data()
+        assert len(frames) == 3*1279
+        for i in range(3):
+            assert tuple(frames[i*1279:i*1279+4]) == (0x1a, 0xcf, 0xfc, 0x1d)
+        assert enc.num_frames() == 3
+
+    def test_003_continuous (self):
+        # with no pdus queued the encoder keeps sending idle frames
+        enc = ccsds.ccsds_encoder(0, "", continuous=True)
+        head = blocks.head(gr.sizeof_char, 4*1279)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(enc, head, dst)
+        self.tb.run()
+
+        frames = dst.data()
+        assert len(frames) == 4*1279
+        assert tuple(frames[0:1279]) == tuple(frames[3*1279:4*1279])
+        assert enc.num_idle_frames() == enc.num_frames()
+
+    def test_004_segment (self):
+        # a space packet longer than a frame is split over two frames. in
+        # continuous mode the second one goes out at once with the rest
+        # filled by an idle packet, and an idle frame follows.
+        length = 1500
+        packet = [0x00, 0x64, 0xc0, 0x00, (length-7) >> 8, (length-7) & 0xff]
+        packet += [x%256 for x in range(length-6)]
+        msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(packet), packet))
+
+        # without scrambling the data of an interleaved frame is in order
+        # after the sync word
+        enc = ccsds.ccsds_encoder(0, "", scramble=False, continuous=True,
+                                  segment=True, scid=42, vcid=1)
+        head = blocks.head(gr.sizeof_char, 3*1279)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(enc, head, dst)
+        enc.to_basic_block()._post(pmt.intern("in"), msg)
+        self.tb.run()
+
+        out = dst.data()
+        assert len(out) == 3*1279
+        frames = [out[i*1279+4:i*1279+4+1115] for i in range(3)]
+        headers = [parse_tm_header(f) for f in frames]
+        # (scid, vcid, mc count, vc count, first header pointer)
+        assert headers[0] == (42, 1, 0, 0, 0)
+        assert headers[1] == (42, 1, 1, 1, 1500-1109)
+        assert headers[2] == (42, 7, 2, 0, 0x7fe)
+        assert list(frames[0][6:]) + list(frames[1][6:6+391]) == packet
+        idle = frames[1][6+391:]
+        assert ((idle[0] & 0x07) << 8) | idle[1] == 0x7ff
+        assert ((idle[4] << 8) | idle[5]) + 7 == len(idle)
+
+    def test_004a_segment_flush (self):
+        # without continuous mode a partial frame is held for flush_timeout,
+        # then sent with the rest filled by an idle packet
+        length = 500
+        packet = [0x00, 0x64, 0xc0, 0x00, (length-7) >> 8, (length-7) & 0xff]
+        packet += [x%256 for x in range(length-6)]
+        msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(packet), packet))
+
+        enc = ccsds.ccsds_encoder(0, "", scramble=False, segment=True, vcid=2,
+                                  flush_timeout=0.05)
+        head = blocks.head(gr.sizeof_char, 1279)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(enc, head, dst)
+        enc.to_basic_block()._post(pmt.intern("in"), msg)
+        self.tb.run()
+
+        frame = dst.data()[4:4+1115]
+        assert parse_tm_header(frame) == (0, 2, 0, 0, 0)
+        assert list(frame[6:6+length]) == packet
+        idle = frame[6+length:]
+        assert ((idle[0] & 0x07) << 8) | idle[1] == 0x7ff
+        assert enc.num_frames() == 1
+
+    def test_005_output_format (self):
+        # unpacked and soft output carry the same bits as packed output
+        src_data = [x%256 for x in range(2*1115)]
+        outputs = []
+        for fmt, sink in ((ccsds.OUTPUT_PACKED, blocks.vector_sink_b()),
+                          (ccsds.OUTPUT_UNPACKED, blocks.vector_sink_b()),
+                          (ccsds.OUTPUT_SOFT, blocks.vector_sink_f())):
+            tb = gr.top_block()
+            src = blocks.vector_source_b(src_data)
+            enc = ccsds.ccsds_encoder(gr.sizeof_char, "", output_format=fmt)
+            tb.connect(src, enc, sink)
+            tb.run()
+            outputs.append(sink.data())
+
+        packed, unpacked, soft = outputs
+        bits = [(b >> (7-j)) & 1 for b in packed for j in range(8)]
+        assert list(unpacked) == bits
+        assert list(soft) == [1.0 if b else -1.0 for b in bits]
+
+    def test_006_rs_code (self):
+        # (255,239) code shortened by 100 symbols, 5 blocks of 139 data
+        # and 16 parity bytes per frame
+        src_data = [x%256 for x in range(2*695)]
+        src = blocks.vector_source_b(src_data)
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "", rs_e=8, virtual_fill=100)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, enc, dst)
+        self.tb.run()
+
+        frames = dst.data()
+        assert len(frames) == 2*779
+        assert tuple(frames[779:779+4]) == (0x1a, 0xcf, 0xfc, 0x1d)
+        assert enc.num_frames() == 2
+
+    def test_007_fecf (self):
+        # with the fecf appended frames take two bytes less data, and the
+        # decoder finds the crc correct
+        src_data = [x%256 for x in range(2*1113)]
+        src = blocks.vector_source_b(src_data)
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "", fecf=True,
+                                  output_format=ccsds.OUTPUT_UNPACKED)
+        dec = ccsds.ccsds_decoder(check_fecf=True)
+        self.tb.connect(src, enc, dec)
+        self.tb.run()
+
+        assert enc.num_frames() == 2
+        assert dec.num_frames_decoded() == 2
+        assert dec.num_fecf_errors() == 0
+
 if __name__ == '__main__':
     gr_unittest.run(qa_ccsds_encoder, "qa_ccsds_encoder.xml")
@@ -149,5 +149,116 @@ class qa_correlator (gr_unittest.TestCase):
         assert frame_len == len(data_out)
         assert random_data == data_out
 
+    def test_005_frame_lengths (self):
+        # frames packed in bulk and bit by bit across work calls
+        for frame_len in (1, 7, 223, 1115):
+            self.tb = gr.top_block()
+            asm = (0x1a, 0xcf, 0xfc, 0x1d)
+            random_data = tuple(random.randint(0, 255) for _ in range(frame_len))
+
+            data_in = asm + random_data
+
+            src = blocks.vector_source_b(data_in, repeat=True)
+            unpack = blocks.unpack_k_bits_bb(8)
+            mapper = digital.map_bb((1,0))
+            corr = ccsds.correlator(0x1acffc1d, 0xffffffff, 0, frame_len)
+            dbg = blocks.message_debug()
+            self.tb.connect(src, unpack, mapper, corr)
+            self.tb.msg_connect((corr, 'out'), (dbg, 'store'))
+            self.tb.start()
+
+            while dbg.num_messages() < 2:
+                time.sleep(0.001)
+
+            self.tb.stop()
+            self.tb.wait()
+
+            for i in range(2):
+                data_out = tuple(pmt.to_python(pmt.cdr(dbg.get_message(i))))
+                assert random_data == data_out
+
+    def test_006_multiple_asms (self):
+        # a 32 bit and a 64 bit marker with different frame lengths
+        asm_a = (0x1a, 0xcf, 0xfc, 0x1d)
+        asm_b = (0x03, 0x47, 0x76, 0xc7, 0x27, 0x28, 0x95, 0xb0)
+        data_a = tuple(random.randint(0, 255) for _ in range(223))
+        data_b = tuple(random.randint(0, 255) for _ in range(100))
+
+        data_in = asm_a + data_a + asm_b + data_b
+
+        src = blocks.vector_source_b(data_in, repeat=True)
+        unpack = blocks.unpack_k_bits_bb(8)
+        corr = ccsds.correlator([0x1acffc1d, 0x034776c7272895b0],
+                                [0xffffffff, 0xffffffffffffffff],
+                                [0, 0], [223, 100])
+        dbg = blocks.message_debug()
+        self.tb.connect(src, unpack, corr)
+        self.tb.msg_connect((corr, 'out'), (dbg, 'store'))
+        self.tb.start()
+
+        while dbg.num_messages() < 2:
+            time.sleep(0.001)
+
+        self.tb.stop()
+        self.tb.wait()
+
+        for i in range(2):
+            msg = dbg.get_message(i)
+            index = pmt.to_uint64(pmt.dict_ref(pmt.car(msg), pmt.intern('asm_index'), pmt.PMT_NIL))
+            data_out = tuple(pmt.to_python(pmt.cdr(msg)))
+            assert data_out == (data_a, data_b)[index]
+
+    def test_007_bit_slip (self):
+        # one bit of the second frame is lost, so the third asm is early
+        asm = (0x1a, 0xcf, 0xfc, 0x1d)
+        frame_len = 223
+        frames = [tuple(random.randint(0, 255) for _ in range(frame_len)) for _ in range(3)]
+
+        bits = []
+        for frame in frames:
+            bits += [(b >> (7 - i)) & 1 for b in asm + frame for i in range(8)]
+        del bits[(4 + frame_len + 4 + 100) * 8]
+        bits += [0] * 64
+
+        src = blocks.vector_source_b(bits)
+        corr = ccsds.correlator(0x1acffc1d, 0xffffffff, 0, frame_len, 4)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, corr)
+        self.tb.msg_connect((corr, 'out'), (dbg, 'store'))
+        self.tb.run()
+
+        assert dbg.num_messages() == 3
+        assert frames[0] == tuple(pmt.to_python(pmt.cdr(dbg.get_message(0))))
+        assert frames[2] == tuple(pmt.to_python(pmt.cdr(dbg.get_message(2))))
+        assert corr.num_bit_slips() == 1
+
+    def test_008_nrzm (self):
+        # nrz-m coded input, also through an inverted channel
+        asm = (0x1a, 0xcf, 0xfc, 0x1d)
+        frame_len = 223
+        random_data = tuple(random.randint(0, 255) for _ in range(frame_len))
+
+        data_in = asm + random_data
+
+        src = blocks.vector_source_b(data_in, repeat=True)
+        unpack = blocks.unpack_k_bits_bb(8)
+        diff = digital.diff_encoder_bb(2)
+        mapper = digital.map_bb((1,0))
+        corr = ccsds.correlator(0x1acffc1d, 0xffffffff, 0, frame_len, nrzm=True)
+        dbg = blocks.message_debug()
+        self.tb.connect(src, unpack, diff, mapper, corr)
+        self.tb.msg_connect((corr, 'out'), (dbg, 'store'))
+        self.tb.start()
+
+        while dbg.num_messages() < 2:
+            time.sleep(0.001)
+
+        self.tb.stop()
+        self.tb.wait()
+
+        for i in range(2):
+            data_out = tuple(pmt.to_python(pmt.cdr(dbg.get_message(i))))
+            assert random_data == data_out
+
 if __name__ == '__main__':
     gr_unittest.run(qa_correlator, "qa_correlator.xml")
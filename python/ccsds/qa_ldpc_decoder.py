@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+import time
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+class qa_ldpc_decoder (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def decode (self, vec):
+        dec = ccsds.ldpc_decoder(ccsds.LDPC_C2, 50, False)
+        dbg = blocks.message_debug()
+        self.tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        self.tb.start()
+        dec.to_basic_block()._post(pmt.intern('in'), pmt.cons(pmt.PMT_NIL, vec))
+
+        timeout = time.time() + 5
+        while dbg.num_messages() < 1 and time.time() < timeout:
+            time.sleep(0.01)
+
+        self.tb.stop()
+        self.tb.wait()
+        return dec, dbg
+
+    def test_001_hard_bit_errors (self):
+        # the all zero codeword with a few flipped bits
+        codeblock = [0] * 1020
+        for i in random.sample(range(8158), 20):
+            codeblock[i // 8] ^= 0x80 >> (i % 8)
+
+        dec, dbg = self.decode(pmt.init_u8vector(len(codeblock), codeblock))
+
+        assert dbg.num_messages() == 1
+        msg = dbg.get_message(0)
+        data_out = tuple(pmt.to_python(pmt.cdr(msg)))
+        assert data_out == (0,) * 892
+        assert pmt.to_long(pmt.dict_ref(pmt.car(msg), pmt.intern('iterations'), pmt.PMT_NIL)) > 0
+        assert dec.num_frames_decoded() == 1
+
+    def test_002_soft_symbols (self):
+        # positive soft symbols are ones
+        soft = [-1.0 + random.gauss(0, 0.4) for _ in range(8160)]
+
+        dec, dbg = self.decode(pmt.init_f32vector(len(soft), soft))
+
+        assert dbg.num_messages() == 1
+        data_out = tuple(pmt.to_python(pmt.cdr(dbg.get_message(0))))
+        assert data_out == (0,) * 892
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ldpc_decoder, "qa_ldpc_decoder.xml")
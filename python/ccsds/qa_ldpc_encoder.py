@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+import time
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+# first rows of the C2 generator circulants B1,1 and B1,2 from CCSDS
+# 131.0-B, 511 bits each after a leading zero pad bit
+C2_B11 = ("55BF56CC55283DFEEFEA8C8CFF04E1EBD9067710988E25048D67525426939E20"
+          "68D2DC6FCD2F822BEB6BD96C8A76F4932AAE9BC53AD20A2A9C86BB461E43759C")
+C2_B12 = ("6855AE08698A50AA3051768793DC238544AF3FE987391021AAF6383A6503409C"
+          "3CE971A80B3ECE12363EE809A01D91204F1811123EAB867D3E40E8C652585D28")
+
+def circulant_row (hexrow):
+    return [int(c, 16) >> (3 - i) & 1 for c in hexrow for i in range(4)][1:]
+
+class qa_ldpc_encoder (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_roundtrip (self):
+        # tagged stream in, asm and scrambled codeblock out, then decode it
+        src_data = [random.randint(0, 255) for _ in range(892)]
+        src = blocks.vector_source_b(src_data)
+        s2ts = blocks.stream_to_tagged_stream(gr.sizeof_char, 1, len(src_data), "packet_len")
+        enc = ccsds.ldpc_encoder(gr.sizeof_char, "packet_len", ccsds.LDPC_C2, True)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, s2ts, enc, dst)
+        self.tb.run()
+
+        frame = dst.data()
+        assert len(frame) == 4 + 1020
+        assert tuple(frame[:4]) == (0x1a, 0xcf, 0xfc, 0x1d)
+        assert enc.num_frames() == 1
+
+        tb = gr.top_block()
+        dec = ccsds.ldpc_decoder(ccsds.LDPC_C2, 50, True)
+        dbg = blocks.message_debug()
+        tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        tb.start()
+        codeblock = list(frame[4:])
+        dec.to_basic_block()._post(pmt.intern('in'),
+            pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(codeblock), codeblock)))
+
+        timeout = time.time() + 5
+        while dbg.num_messages() < 1 and time.time() < timeout:
+            time.sleep(0.01)
+
+        tb.stop()
+        tb.wait()
+
+        assert dbg.num_messages() == 1
+        msg = dbg.get_message(0)
+        assert tuple(pmt.to_python(pmt.cdr(msg))) == tuple(src_data)
+        assert pmt.to_long(pmt.dict_ref(pmt.car(msg), pmt.intern('iterations'), pmt.PMT_NIL)) == 0
+
+    def test_002_standard_generator (self):
+        # the first information bit is bit 18 of the (8176,7154) code after
+        # the fill, so its parity is the first generator row rotated by 18
+        src_data = [0x80] + [0] * 891
+        src = blocks.vector_source_b(src_data)
+        s2ts = blocks.stream_to_tagged_stream(gr.sizeof_char, 1, len(src_data), "packet_len")
+        enc = ccsds.ldpc_encoder(gr.sizeof_char, "packet_len", ccsds.LDPC_C2, False)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, s2ts, enc, dst)
+        self.tb.run()
+
+        codeblock = dst.data()[4:]
+        bits = [(b >> (7 - i)) & 1 for b in codeblock for i in range(8)]
+        assert bits[:7136] == [1] + [0] * 7135
+        for b, hexrow in enumerate((C2_B11, C2_B12)):
+            row = circulant_row(hexrow)
+            expected = [row[(k - 18) % 511] for k in range(511)]
+            assert bits[7136 + 511*b:7136 + 511*(b+1)] == expected
+        assert bits[-2:] == [0, 0]
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ldpc_encoder, "qa_ldpc_encoder.xml")
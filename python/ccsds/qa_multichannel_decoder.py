@@ -0,0 +1,118 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+class qa_multichannel_decoder (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def encode(self, frames):
+        # asm and rs encoded codeword per frame, one bit per byte
+        data = [b for frame in frames for b in frame]
+        src = blocks.vector_source_b(data)
+        s2ts = blocks.stream_to_tagged_stream(gr.sizeof_char, 1, 1115, "packet_len")
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "packet_len")
+        unpack = blocks.unpack_k_bits_bb(8)
+        dst = blocks.vector_sink_b()
+        tb = gr.top_block()
+        tb.connect(src, s2ts, enc, unpack, dst)
+        tb.run()
+        return list(dst.data())
+
+    def test_001_channels (self):
+        n_frames = (2, 5, 1)
+        frames = [[[random.randint(0, 255) for _ in range(1115)] for _ in range(n)] for n in n_frames]
+        bits = [self.encode(f) for f in frames]
+        length = max(len(b) for b in bits) + 64
+
+        dec = ccsds.multichannel_decoder(len(n_frames), 0, True, True, True, 5, True, 2)
+        dbg = blocks.message_debug()
+        for i, b in enumerate(bits):
+            noise = [random.randint(0, 1) for _ in range(100 * i)]
+            src = blocks.vector_source_b((noise + b + [0] * length)[:length])
+            self.tb.connect(src, (dec, i))
+        self.tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        self.tb.run()
+
+        received = [[] for _ in n_frames]
+        for i in range(dbg.num_messages()):
+            msg = dbg.get_message(i)
+            ch = pmt.to_long(pmt.dict_ref(pmt.car(msg), pmt.intern('channel'), pmt.PMT_NIL))
+            received[ch].append(list(pmt.to_python(pmt.cdr(msg))))
+
+        for ch, n in enumerate(n_frames):
+            assert received[ch] == frames[ch]
+            assert dec.num_frames_decoded(ch) == n
+
+    def test_002_options (self):
+        # nrz-m input with a 64-bit sync word and the E=8 code, checked
+        # for a fecf on both channels
+        asm = 0x034776c7272895b0
+        asm_bits = [(asm >> (63-i)) & 1 for i in range(64)]
+        n_frames = 3
+        data = [random.randint(0, 255) for _ in range(n_frames * (239 * 5 - 2))]
+        src = blocks.vector_source_b(data)
+        enc = ccsds.ccsds_encoder(gr.sizeof_char, "", rs_e=8, fecf=True,
+                                  output_format=ccsds.OUTPUT_UNPACKED)
+        dst = blocks.vector_sink_b()
+        tb = gr.top_block()
+        tb.connect(src, enc, dst)
+        tb.run()
+        encoded = list(dst.data())
+
+        frame_bits = len(encoded) // n_frames
+        bits = []
+        for f in range(n_frames):
+            bits += asm_bits + encoded[f*frame_bits+32:(f+1)*frame_bits]
+        level = 0
+        for i, b in enumerate(bits):
+            level ^= b
+            bits[i] = level
+        bits += [0] * 64
+
+        dec = ccsds.multichannel_decoder(2, 6, True, True, True, 5, True, 2, nrzm=True,
+                                         asm_=asm, asm_mask=0xffffffffffffffff,
+                                         rs_e=8, check_fecf=True)
+        dbg = blocks.message_debug()
+        for ch in range(2):
+            self.tb.connect(blocks.vector_source_b(bits), (dec, ch))
+        self.tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        self.tb.run()
+
+        assert dbg.num_messages() == 2 * n_frames
+        for ch in range(2):
+            assert dec.num_frames_decoded(ch) == n_frames
+            assert dec.num_fecf_errors(ch) == 0
+        for i in range(dbg.num_messages()):
+            meta = pmt.car(dbg.get_message(i))
+            assert pmt.to_bool(pmt.dict_ref(meta, pmt.intern('fecf_ok'), pmt.PMT_F))
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_multichannel_decoder, "qa_multichannel_decoder.xml")
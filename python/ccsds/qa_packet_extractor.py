@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import time
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+def space_packet (apid, count, length):
+    header = [(apid >> 8) & 0x07, apid & 0xff, 0xc0 | (count >> 8), count & 0xff,
+              (length-7) >> 8, (length-7) & 0xff]
+    return header + [(count + i) % 256 for i in range(length-6)]
+
+def tm_frame (vcid, vc_count, fhp, field):
+    return [0x02, 0xa0 | (vcid << 1), 0, vc_count, 0x18 | (fhp >> 8), fhp & 0xff] + field
+
+def aos_frame (vcid, vc_count, fhp, field):
+    return [0x40 | 0x0a, vcid, 0, 0, vc_count, 0x00, fhp >> 8, fhp & 0xff] + field
+
+class qa_packet_extractor (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def extract (self, ext, frames, nexpected):
+        dbg = blocks.message_debug()
+        dbg_apid = blocks.message_debug()
+        self.tb.msg_connect((ext, 'out'), (dbg, 'store'))
+        self.tb.msg_connect((ext, 'apid0'), (dbg_apid, 'store'))
+        self.tb.start()
+        for frame in frames:
+            msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(frame), frame))
+            ext.to_basic_block()._post(pmt.intern('in'), msg)
+
+        timeout = time.time() + 5
+        while dbg.num_messages() + dbg_apid.num_messages() < nexpected and time.time() < timeout:
+            time.sleep(0.01)
+
+        self.tb.stop()
+        self.tb.wait()
+        packets = lambda d: [list(pmt.to_python(pmt.cdr(d.get_message(i)))) for i in range(d.num_messages())]
+        return packets(dbg), packets(dbg_apid)
+
+    def test_001_tm_spanning (self):
+        # b runs over into the second frame, whose header pointer points
+        # past it to c. the rest of the second frame is an idle packet.
+        a, b, c = space_packet(5, 0, 40), space_packet(6, 1, 90), space_packet(5, 2, 30)
+        idle = space_packet(0x7ff, 0, 30)
+        stream = a + b + c + idle
+        frames = [tm_frame(1, 0, 0, stream[0:100]), tm_frame(1, 1, 30, stream[100:190])]
+
+        ext = ccsds.packet_extractor([6])
+        out, out_apid = self.extract(ext, frames, 3)
+
+        assert out == [a, c]
+        assert out_apid == [b]
+        assert ext.num_packets(5) == 2
+        assert ext.num_packets(6) == 1
+        assert ext.num_packets_dropped() == 0
+
+    def test_002_aos_gap (self):
+        # a missing frame drops the packet it was part of, and the
+        # extractor picks up again at the next header pointer
+        a, b, c = space_packet(5, 0, 60), space_packet(5, 1, 120), space_packet(5, 2, 40)
+        stream = a + b + c
+        frames = [aos_frame(3, 0, 0, stream[0:80]), aos_frame(3, 2, 0x7ff, stream[160:180]),
+                  aos_frame(3, 3, 0, stream[180:220])]
+
+        ext = ccsds.packet_extractor()
+        out, out_apid = self.extract(ext, frames, 2)
+
+        assert out == [a, c]
+        assert ext.num_packets_dropped() == 1
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_packet_extractor, "qa_packet_extractor.xml")
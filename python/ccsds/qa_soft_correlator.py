@@ -0,0 +1,124 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import time
+import random
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+class qa_soft_correlator (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def make_symbols (self, frame_len, sign=1.0, scale=1.0, sigma=0.4):
+        asm = (0x1a, 0xcf, 0xfc, 0x1d)
+        random_data = tuple(random.randint(0, 255) for _ in range(frame_len))
+        bits = [(b >> (7 - i)) & 1 for b in asm + random_data for i in range(8)]
+        symbols = [scale * (sign * (1.0 if b else -1.0) + random.gauss(0, sigma)) for b in bits]
+        return random_data, symbols
+
+    def run_correlator (self, src, corr, index=0):
+        dbg = blocks.message_debug()
+        self.tb.connect(src, corr)
+        self.tb.msg_connect((corr, 'out'), (dbg, 'store'))
+        self.tb.start()
+
+        timeout = time.time() + 5
+        while dbg.num_messages() <= index and time.time() < timeout:
+            time.sleep(0.001)
+
+        self.tb.stop()
+        self.tb.wait()
+        return dbg.get_message(index)
+
+    def check_frame (self, msg, random_data):
+        soft = pmt.to_python(pmt.cdr(msg))
+        assert len(soft) == 8 * len(random_data)
+        data_out = tuple(sum((soft[8*i + j] > 0) << (7 - j) for j in range(8))
+                         for i in range(len(random_data)))
+        assert random_data == data_out
+
+    def test_001_float (self):
+        frame_len = 223
+        random_data, symbols = self.make_symbols(frame_len)
+
+        src = blocks.vector_source_f(symbols, repeat=True)
+        corr = ccsds.soft_correlator(gr.sizeof_float, 0x1acffc1d, 32, 0.6, frame_len)
+        msg = self.run_correlator(src, corr)
+
+        assert pmt.is_f32vector(pmt.cdr(msg))
+        self.check_frame(msg, random_data)
+
+    def test_002_inverted (self):
+        frame_len = 223
+        random_data, symbols = self.make_symbols(frame_len, -1.0)
+
+        src = blocks.vector_source_f(symbols, repeat=True)
+        corr = ccsds.soft_correlator(gr.sizeof_float, 0x1acffc1d, 32, 0.6, frame_len)
+        msg = self.run_correlator(src, corr)
+
+        assert pmt.to_bool(pmt.dict_ref(pmt.car(msg), pmt.intern('inverted'), pmt.PMT_F))
+        self.check_frame(msg, random_data)
+
+    def test_003_int8 (self):
+        frame_len = 223
+        random_data, symbols = self.make_symbols(frame_len)
+
+        src = blocks.vector_source_f(symbols, repeat=True)
+        to_char = blocks.float_to_char(1, 32)
+        corr = ccsds.soft_correlator(gr.sizeof_char, 0x1acffc1d, 32, 0.6, frame_len)
+        self.tb.connect(src, to_char)
+        msg = self.run_correlator(to_char, corr)
+
+        assert pmt.is_s8vector(pmt.cdr(msg))
+        self.check_frame(msg, random_data)
+
+    def test_004_low_snr (self):
+        # the threshold follows the noise at any scale, and the frame is
+        # aligned on the peak, so only symbol errors remain
+        random.seed(4)
+        frame_len = 223
+        sigma = 0.7
+        symbols = []
+        frames = []
+        for _ in range(20):
+            random_data, s = self.make_symbols(frame_len, scale=0.01, sigma=sigma)
+            frames.append(random_data)
+            symbols += s
+
+        src = blocks.vector_source_f(symbols)
+        corr = ccsds.soft_correlator(gr.sizeof_float, 0x1acffc1d, 32, 0.6, frame_len)
+        msg = self.run_correlator(src, corr, 10)
+
+        soft = pmt.to_python(pmt.cdr(msg))
+        bits = [(b >> (7 - i)) & 1 for b in frames[10] for i in range(8)]
+        errors = sum((x > 0) != b for x, b in zip(soft, bits))
+        assert errors < 0.15 * len(bits)
+        assert abs(corr.snr() * sigma**2 - 1.0) < 0.3
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_soft_correlator, "qa_soft_correlator.xml")
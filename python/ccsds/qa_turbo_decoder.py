@@ -0,0 +1,126 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+import time
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+PRIMES = [31, 37, 43, 47, 53, 59, 61, 67]
+
+def parity(x):
+    return bin(x).count('1') & 1
+
+def interleaver(k):
+    k2 = k // 8
+    perm = []
+    for s in range(1, k + 1):
+        m = (s - 1) % 2
+        i = (s - 1) // (2 * k2)
+        j = (s - 1) // 2 - i * k2
+        t = (19 * i + 1) % 4
+        c = (PRIMES[t % 8] * j + 21 * m) % k2
+        perm.append(2 * (t + c * 4 + 1) - m - 1)
+    return perm
+
+def turbo_encode(bits):
+    # rate 1/3: 0a 1a 1b per step, both encoders terminated
+    k = len(bits)
+    perm = interleaver(k)
+    out = []
+    for inputs in (bits, [bits[p] for p in perm]):
+        state = 0
+        syms = []
+        for t in range(k + 4):
+            u = inputs[t] if t < k else parity(state & 0x3)
+            w = u ^ parity(state & 0x3)
+            reg = (w << 4) | state
+            syms.append((u, parity(reg & 0x1b)))
+            state = reg >> 1
+        out.append(syms)
+    code = []
+    for t in range(k + 4):
+        code += [out[0][t][0], out[0][t][1], out[1][t][1]]
+    return code
+
+def crc16(data):
+    crc = 0xffff
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xffff
+    return crc
+
+def scrambler(n):
+    reg = [1] * 8
+    out = []
+    for _ in range(n):
+        out.append(reg[0])
+        reg = reg[1:] + [reg[0] ^ reg[3] ^ reg[5] ^ reg[7]]
+    return out
+
+class qa_turbo_decoder (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def make_frame (self, prn):
+        data = [random.randint(0, 255) for _ in range(221)]
+        crc = crc16(data)
+        data += [crc >> 8, crc & 0xff]
+        bits = [(data[i // 8] >> (7 - i % 8)) & 1 for i in range(1784)]
+        code = turbo_encode(bits)
+        soft = [(1.0 if c ^ p else -1.0) + random.gauss(0, 0.5) for c, p in zip(code, prn)]
+        return data, pmt.init_f32vector(len(soft), soft)
+
+    def test_001_ordered_threads (self):
+        dec = ccsds.turbo_decoder(1784, 3, 10, True, True, 2)
+        dbg = blocks.message_debug()
+        self.tb.msg_connect((dec, 'out'), (dbg, 'store'))
+
+        prn = scrambler(3 * 1788)
+        frames = [self.make_frame(prn) for _ in range(4)]
+
+        self.tb.start()
+        for data, vec in frames:
+            dec.to_basic_block()._post(pmt.intern('in'), pmt.cons(pmt.PMT_NIL, vec))
+
+        timeout = time.time() + 10
+        while dbg.num_messages() < len(frames) and time.time() < timeout:
+            time.sleep(0.01)
+
+        self.tb.stop()
+        self.tb.wait()
+
+        assert dbg.num_messages() == len(frames)
+        for i, (data, vec) in enumerate(frames):
+            assert tuple(pmt.to_python(pmt.cdr(dbg.get_message(i)))) == tuple(data)
+        assert dec.num_frames_decoded() == len(frames)
+        assert dec.num_frames_failed() == 0
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_turbo_decoder, "qa_turbo_decoder.xml")
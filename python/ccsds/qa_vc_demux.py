@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import time
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import ccsds_python as ccsds
+
+def tm_frame (scid, vcid, vc_count):
+    header = [(scid >> 4) & 0x3f, ((scid & 0x0f) << 4) | (vcid << 1), 0, vc_count, 0x18, 0x00]
+    return header + [0x55] * 100
+
+def aos_frame (scid, vcid, vc_count):
+    header = [0x40 | (scid >> 2), ((scid & 0x03) << 6) | vcid,
+              (vc_count >> 16) & 0xff, (vc_count >> 8) & 0xff, vc_count & 0xff, 0x00]
+    return header + [0x55] * 100
+
+class qa_vc_demux (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def run_frames (self, demux, frames, nports, nexpected):
+        dbgs = [blocks.message_debug() for _ in range(nports)]
+        for i, dbg in enumerate(dbgs):
+            self.tb.msg_connect((demux, 'out%d' % i), (dbg, 'store'))
+        self.tb.start()
+        for frame in frames:
+            msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(frame), frame))
+            demux.to_basic_block()._post(pmt.intern('in'), msg)
+
+        timeout = time.time() + 5
+        while sum(d.num_messages() for d in dbgs) < nexpected and time.time() < timeout:
+            time.sleep(0.01)
+
+        self.tb.stop()
+        self.tb.wait()
+        return dbgs
+
+    def test_001_tm (self):
+        # frames are routed by vcid, other channels and spacecraft dropped
+        frames = [tm_frame(42, 1, 0), tm_frame(42, 2, 7), tm_frame(42, 1, 1),
+                  tm_frame(42, 5, 0), tm_frame(43, 1, 2), tm_frame(42, 1, 4)]
+        demux = ccsds.vc_demux([1, 2], 42)
+        dbgs = self.run_frames(demux, frames, 2, 4)
+
+        assert dbgs[0].num_messages() == 3
+        assert dbgs[1].num_messages() == 1
+        assert tuple(pmt.to_python(pmt.cdr(dbgs[1].get_message(0)))) == tuple(frames[1])
+        assert demux.num_frames(1) == 3
+        assert demux.num_gaps(1) == 1
+        assert demux.num_lost_frames(1) == 2
+        assert demux.num_frames_dropped() == 2
+
+    def test_002_aos_count_wraps (self):
+        # the 24 bit aos frame count wraps without a gap
+        frames = [aos_frame(200, 33, 0xfffffe), aos_frame(200, 33, 0xffffff),
+                  aos_frame(200, 33, 0), aos_frame(200, 33, 2)]
+        demux = ccsds.vc_demux([33])
+        self.run_frames(demux, frames, 1, 4)
+
+        assert demux.num_frames(33) == 4
+        assert demux.num_gaps(33) == 1
+        assert demux.num_lost_frames(33) == 1
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_vc_demux, "qa_vc_demux.xml")
@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2026 André Løfaldli.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+import random
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import ccsds_python as ccsds
+
+def conv_encode(bits):
+    # CCSDS k=7 r=1/2 code with the second symbol inverted
+    reg = 0
+    symbols = []
+    for b in bits:
+        reg = ((reg << 1) | b) & 0x7f
+        symbols.append(bin(reg & 0x4f).count('1') % 2)
+        symbols.append(1 - bin(reg & 0x6d).count('1') % 2)
+    return symbols
+
+class qa_viterbi_decoder (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def run_decoder (self, soft, n_threads, segment_len, margin):
+        src = blocks.vector_source_f(soft)
+        dec = ccsds.viterbi_decoder(n_threads, segment_len, margin, True)
+        dst = blocks.vector_sink_b()
+        self.tb = gr.top_block ()
+        self.tb.connect(src, dec, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_001_noiseless (self):
+        segment_len = 1024
+        margin = 64
+        bits = [random.randint(0, 1) for _ in range(8*segment_len + margin)]
+        soft = [2.0*s - 1.0 for s in conv_encode(bits)]
+
+        data_out = self.run_decoder(soft, 1, segment_len, margin)
+
+        assert len(data_out) == 8*segment_len
+        assert tuple(bits[:len(data_out)]) == tuple(data_out)
+
+    def test_002_threads_bit_exact (self):
+        segment_len = 1024
+        margin = 64
+        bits = [random.randint(0, 1) for _ in range(8*segment_len + margin)]
+        soft = [2.0*s - 1.0 + random.gauss(0, 0.6) for s in conv_encode(bits)]
+
+        single = self.run_decoder(soft, 1, segment_len, margin)
+        multi = self.run_decoder(soft, 4, segment_len, margin)
+
+        assert len(single) == len(multi)
+        assert single == multi
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_viterbi_decoder, "qa_viterbi_decoder.xml")